@@ -3,18 +3,35 @@
 #include <tuple>
 #include <cmath>
 #include <cstdlib>
+#include <climits>
 #include <ctime>
 #include <algorithm>
 #include <random>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <unordered_map>
 #include <cstring>      // strcpy, strtok, strlen
 #include <cstdio>       // FILE*, fopen, fgets, fprintf, fclose
 #include <getopt.h>     // getopt_long
 #include <sqlite3.h>    // SQLite3
 #include <pthread.h>    // pthread
 #include <unistd.h>     // sleep, system
+#include <fcntl.h>      // open
+#include <sys/stat.h>   // stat
 #include <ncurses.h>    // ncurses
-#ifdef USE_OPENCV
-#include <opencv2/opencv.hpp>  // OpenCV
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>  // perf_event_open
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
 #endif
 #include "httplib.h"    // httplib.h (cpp-httplib)
 
@@ -33,241 +50,4025 @@ struct AP {
 vector<AP> kullanicilar;         // Burada kullanıcı listesi, zafiyetler için
 vector<AP> en_iyi_birey;
 double en_iyi_skor = -1e9;
+atomic<uint64_t> degerlendirmeSayisi{0};  // Tam ve artımlı uygunluk değerlendirmeleri
+
+// Çok amaçlı mod (NSGA-II) çıktısı: baskılanmayan çözümler ve hedef değerleri
+struct ParetoCozum {
+    double kapsanan;      // Kapsanan toplam talep (büyük iyi)
+    int kanal_cezasi;     // Aynı kanalda çakışan AP çifti (küçük iyi)
+    int ap_sayisi;        // Kullanılan AP sayısı (küçük iyi)
+    vector<AP> aps;
+};
+
+vector<ParetoCozum> paretoKumesi;
 
 int AP_SAYISI = 0;
-double globalOrtalamaFitness = 0.0;
-bool dur = false;
+int AP_MIN = 0, AP_MAX = 0;      // Değişken uzunluklu genom sınırları; 0 ise AP_SAYISI
+double AP_MALIYETI = 0.0;        // Uygunluktan AP başına düşülen maliyet
+double VERIM_AGIRLIGI = 0.0;     // Uygunluğa eklenen tahmini verim (Mbps) ağırlığı; 0 = hesaplanmaz
+int POP_BOYUTU = 0;              // 0 ise AP_SAYISI kullanılır
+
+enum CalismaModu { MOD_GA, MOD_NSGA2 };
+CalismaModu calismaModu = MOD_GA;
+
+// Kanal ataması çözücüsü: kapalı, yalnızca en iyi bireye son işlem, ya da her epoch elitlere
+enum KanalCozucuModu { KC_KAPALI, KC_EN_IYI, KC_ELITLER };
+KanalCozucuModu kanalCozucuModu = KC_KAPALI;
+int kanalTabuIterasyon = 2000;
+
+// Zaman bütçeli (anytime) mod: son tarih aktifse değerlendirme ve yerel arama
+// döngüleri her adımda kontrol eder, böylece aşım tek bir adımla sınırlı kalır.
+// Son tarih çalıştırmaya aittir (CalismaBaglami), süreç geneli değildir.
+struct SonTarih {
+    bool aktif = false;
+    chrono::steady_clock::time_point zaman;
+
+    bool gecti() const { return aktif && chrono::steady_clock::now() >= zaman; }
+};
+
+double sonTarihMs = 0;           // --deadline-ms; 0 ise normal mod
+
+// Canlı panelden: epoch sınırında duraklatma ve kullanıcı durdurması
+atomic<bool> duraklatildi{false}, durdurIstegi{false};
+
+// Talep istatistikleri kullanıcı yüklendikçe Welford yöntemiyle artımlı
+// tutulur; tarama yapan bir thread yoktur. Okuyucular atomik kopyaları görür.
+struct TalepIstatistigi {
+    uint64_t adet = 0;
+    double ortalama = 0.0, m2 = 0.0;
+
+    void ekle(double t) {
+        adet++;
+        double fark = t - ortalama;
+        ortalama += fark / adet;
+        m2 += fark * (t - ortalama);
+    }
+    double varyans() const { return adet > 1 ? m2 / (adet - 1) : 0.0; }
+};
+
+TalepIstatistigi talepIst;                     // Yalnızca kullanıcı ekleyen thread yazar
+atomic<double> globalOrtalamaFitness{0.0};     // Ortalama kullanıcı talebi
+atomic<double> talepVaryansi{0.0};
+
+void kullaniciEkle(const AP& k) {
+    kullanicilar.push_back(k);
+    talepIst.ekle(k.talep);
+    globalOrtalamaFitness.store(talepIst.ortalama, memory_order_relaxed);
+    talepVaryansi.store(talepIst.varyans(), memory_order_relaxed);
+}
+
+atomic<bool> dur{false};
 sqlite3* db = nullptr;
 string configDosya = "config.txt";
 
-// Random generator
-random_device rd;
-mt19937 gen(rd());
-uniform_real_distribution<> rand01(0.0, 1.0);
+// ------------------------------------------------------
+// Rastgele Sayı Üreteci: tohumlanabilir xoshiro256++ akışları
+// ------------------------------------------------------
+// Her akış ana tohumdan türetilir; k numaralı akış ana durumu k kez 2^128
+// adım ileri atlatarak elde edilir, yani akışlar asla örtüşmez. Her thread
+// (veya ada) kendi akışını RastgeleAkisKapsami ile bağlar; paylaşılan bir
+// üreteç ve kilit yoktur, aynı tohum ve akış numarası aynı diziyi verir.
+
+struct Xoshiro256pp {
+    uint64_t s[4];
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    void tohumla(uint64_t tohum) {
+        for (auto& v : s) v = splitmix64(tohum);
+    }
+
+    uint64_t sonraki() {
+        uint64_t sonuc = rotl(s[0] + s[3], 23) + s[0];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return sonuc;
+    }
+
+    // 2^128 adım ileri: bağımsız alt akış başlangıcı
+    void atla() {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t j : JUMP) {
+            for (int b = 0; b < 64; b++) {
+                if (j & (1ULL << b)) { t[0] ^= s[0]; t[1] ^= s[1]; t[2] ^= s[2]; t[3] ^= s[3]; }
+                sonraki();
+            }
+        }
+        memcpy(s, t, sizeof(s));
+    }
+
+    // [0, 1) aralığında double: üst 53 bit
+    double birim() { return (sonraki() >> 11) * 0x1.0p-53; }
+
+    // [0, aralik) içinde sapmasız tamsayı (Lemire çarpma + ret yöntemi)
+    uint32_t sinirli(uint32_t aralik) {
+        uint64_t m = (uint64_t)(uint32_t)(sonraki() >> 32) * aralik;
+        uint32_t alt = (uint32_t)m;
+        if (alt < aralik) {
+            uint32_t esik = (uint32_t)(-aralik) % aralik;
+            while (alt < esik) {
+                m = (uint64_t)(uint32_t)(sonraki() >> 32) * aralik;
+                alt = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+};
+
+uint64_t anaTohum = 0x5eed5eed5eed5eedULL;
+Xoshiro256pp anaAkis;                          // Ana thread'in akışı (akış 0)
+thread_local Xoshiro256pp* yerelAkis = nullptr;
+
+Xoshiro256pp akisOlustur(uint64_t akisNo) {
+    Xoshiro256pp a;
+    a.tohumla(anaTohum);
+    for (uint64_t i = 0; i < akisNo; i++) a.atla();
+    return a;
+}
+
+void rastgeleBaslat(uint64_t tohum) {
+    anaTohum = tohum;
+    anaAkis = akisOlustur(0);
+}
+
+inline Xoshiro256pp& rng() { return yerelAkis ? *yerelAkis : anaAkis; }
+
+// Kapsam süresince bu thread'i verilen akışa bağlar
+struct RastgeleAkisKapsami {
+    Xoshiro256pp akis;
+    Xoshiro256pp* onceki;
+    explicit RastgeleAkisKapsami(uint64_t akisNo) : akis(akisOlustur(akisNo)), onceki(yerelAkis) { yerelAkis = &akis; }
+    explicit RastgeleAkisKapsami(const Xoshiro256pp& a) : akis(a), onceki(yerelAkis) { yerelAkis = &akis; }
+    ~RastgeleAkisKapsami() { yerelAkis = onceki; }
+};
+
+inline double rand01() { return rng().birim(); }
 
 int randint(int min, int max) {
-    uniform_int_distribution<> dis(min, max - 1);
-    return dis(gen);
+    return min + (int)rng().sinirli((uint32_t)(max - min));
+}
+
+// Standart normal (Marsaglia polar); std::normal_distribution'dan farklı
+// olarak her platformda aynı diziyi üretir.
+double rastgeleNormal() {
+    Xoshiro256pp& r = rng();
+    double u, v, q;
+    do {
+        u = 2.0 * r.birim() - 1.0;
+        v = 2.0 * r.birim() - 1.0;
+        q = u * u + v * v;
+    } while (q >= 1.0 || q == 0.0);
+    return u * sqrt(-2.0 * log(q) / q);
+}
+
+// Toplu üretim: sıcak döngülerde tek tek çağrı yerine tampon doldurur
+void topluRand01(double* cikti, int n) {
+    Xoshiro256pp& r = rng();
+    for (int i = 0; i < n; i++) cikti[i] = r.birim();
+}
+
+void topluRandint(int* cikti, int n, int min, int max) {
+    Xoshiro256pp& r = rng();
+    uint32_t aralik = (uint32_t)(max - min);
+    for (int i = 0; i < n; i++) cikti[i] = min + (int)r.sinirli(aralik);
 }
 
 // ------------------------------------------------------
-// Zafiyet Test Fonksiyonları
+// Görev Zamanlayıcı: iş çalan (work-stealing) thread havuzu
 // ------------------------------------------------------
+// Uygunluk partileri, yerel arama ve kalıcılık (dosya/veritabanı) işleri
+// aynı havuzdan geçer; alt sistemler kendi thread'lerini açmaz. Her işçinin
+// kendi deque'si vardır: sahibi arkadan (LIFO, önbellekte sıcak) alır, boşta
+// kalan işçi önce aynı NUMA düğümündeki, sonra diğer kuyrukların önünden
+// (FIFO) çalar. Bekleyen thread boş durmaz, kuyruklardan iş çalıştırır; bu
+// sayede iç içe paralellik (birey partisi içinde dilimli değerlendirme)
+// kilitlenmez. Grup iptal edilirse kuyruktaki işleri atlanır, çalışanlar
+// iptalEdildi() ile sorgulayıp erken çıkabilir. durdur() kuyrukları boşaltıp
+// işçileri bekler.
 
-// 🔥 Null pointer dereference zafiyeti
-void test_null_pointer() {
-    int* ptr = nullptr;
-    if (randint(0, 20) == 7) {
-        *ptr = 10;  // Crash edebilir
+struct GorevGrubu {
+    atomic<int> bekleyen{0};
+    atomic<bool> iptal{false};
+    mutex m;
+    condition_variable bitti;
+
+    void iptalEt() { iptal = true; }
+    bool iptalEdildi() const { return iptal.load(memory_order_relaxed); }
+};
+
+struct Gorev {
+    function<void()> is;
+    GorevGrubu* grup = nullptr;
+};
+
+struct IsciKuyrugu {
+    mutex m;
+    deque<Gorev> q;
+    atomic<uint64_t> mesgulNs{0}, gorevSayisi{0};   // Panel için kullanım
+};
+
+thread_local int gorevDerinligi = 0;   // Yardım ederken çalışan iç görevler çift sayılmasın
+
+thread_local int zamanlayiciIsciNo = -1;   // -1: havuz dışındaki thread
+
+// /sys/devices/system/node altındaki düğümlerin CPU listeleri; yoksa tek düğüm
+vector<vector<int>> numaDugumleri() {
+    vector<vector<int>> dugumler;
+    for (int d = 0; ; d++) {
+        char yol[96], satir[1024] = {0};
+        snprintf(yol, sizeof(yol), "/sys/devices/system/node/node%d/cpulist", d);
+        FILE* f = fopen(yol, "r");
+        if (!f) break;
+        if (fgets(satir, sizeof(satir), f)) {
+            vector<int> cpular;
+            for (char* p = strtok(satir, ",\n"); p; p = strtok(nullptr, ",\n")) {
+                int a, b;
+                int k = sscanf(p, "%d-%d", &a, &b);
+                if (k == 1) b = a;
+                if (k >= 1) for (int c = a; c <= b; c++) cpular.push_back(c);
+            }
+            if (!cpular.empty()) dugumler.push_back(cpular);
+        }
+        fclose(f);
     }
+    if (dugumler.empty()) {
+        dugumler.emplace_back();
+        for (long c = 0; c < max(1L, sysconf(_SC_NPROCESSORS_ONLN)); c++) dugumler[0].push_back((int)c);
+    }
+    return dugumler;
 }
 
-// 🔥 Uninitialized variable zafiyeti
-int belirsiz_kullan() {
-    int x;               // Başlatılmadı
-    return x + 1;        // Undefined behavior
+struct GorevZamanlayici {
+    vector<unique_ptr<IsciKuyrugu>> kuyruklar;
+    vector<vector<int>> kurbanSirasi;    // İşçi başına çalma sırası: önce aynı düğüm
+    vector<int> cekirdek;                // Sabitlenen CPU (-1 = serbest)
+    vector<pthread_t> isciler;
+    mutex uykuM;
+    condition_variable uyku;
+    atomic<int> kuyrukta{0};
+    atomic<unsigned> dagitici{0};
+    atomic<bool> kapat{false};
+
+    int boyut() const { return (int)isciler.size(); }
+
+    struct Baslangic { GorevZamanlayici* z; int no; };
+
+    static void* isciDongusu(void* arg) {
+        Baslangic b = *(Baslangic*)arg;
+        delete (Baslangic*)arg;
+        GorevZamanlayici* z = b.z;
+        zamanlayiciIsciNo = b.no;
+        if (z->cekirdek[b.no] >= 0) {
+            cpu_set_t kume;
+            CPU_ZERO(&kume);
+            CPU_SET(z->cekirdek[b.no], &kume);
+            pthread_setaffinity_np(pthread_self(), sizeof(kume), &kume);  // Başarısızsa serbest kalır
+        }
+        for (;;) {
+            if (z->birGorevCalistir(b.no)) continue;
+            unique_lock<mutex> kilit(z->uykuM);
+            z->uyku.wait(kilit, [&] { return z->kuyrukta > 0 || z->kapat; });
+            if (z->kapat && z->kuyrukta == 0) return nullptr;
+        }
+    }
+
+    void baslat(int n, bool sabitle) {
+        vector<vector<int>> dugumler = numaDugumleri();
+        int D = (int)dugumler.size();
+        vector<int> dugum(n);
+        cekirdek.assign(n, -1);
+        for (int w = 0; w < n; w++) {
+            kuyruklar.emplace_back(new IsciKuyrugu());
+            // İşçiler düğümlere sırayla dağıtılır, düğüm içinde CPU'lar sırayla dolar
+            dugum[w] = w % D;
+            const vector<int>& c = dugumler[dugum[w]];
+            if (sabitle) cekirdek[w] = c[(w / D) % c.size()];
+        }
+        kurbanSirasi.assign(n, {});
+        for (int w = 0; w < n; w++) {
+            for (int yakin = 1; yakin >= 0; yakin--)
+                for (int v = 1; v < n; v++)
+                    if ((dugum[(w + v) % n] == dugum[w]) == (bool)yakin) kurbanSirasi[w].push_back((w + v) % n);
+        }
+        isciler.resize(n);
+        for (int w = 0; w < n; w++) pthread_create(&isciler[w], nullptr, isciDongusu, new Baslangic{this, w});
+    }
+
+    void durdur() {
+        { lock_guard<mutex> kilit(uykuM); kapat = true; }
+        uyku.notify_all();
+        for (auto& t : isciler) pthread_join(t, nullptr);
+        isciler.clear();
+        kuyruklar.clear();
+    }
+
+    void gonder(GorevGrubu& g, function<void()> f) {
+        g.bekleyen++;
+        if (boyut() == 0) { f(); tamamla(g); return; }   // Havuz yoksa yerinde
+        int w = zamanlayiciIsciNo >= 0 ? zamanlayiciIsciNo : (int)(dagitici++ % boyut());
+        {
+            lock_guard<mutex> kilit(kuyruklar[w]->m);
+            kuyruklar[w]->q.push_back(Gorev{move(f), &g});
+        }
+        kuyrukta++;
+        { lock_guard<mutex> kilit(uykuM); }
+        uyku.notify_one();
+    }
+
+    bool al(int w, Gorev& g) {
+        if (w >= 0) {
+            IsciKuyrugu& k = *kuyruklar[w];
+            lock_guard<mutex> kilit(k.m);
+            if (!k.q.empty()) {
+                g = move(k.q.back());
+                k.q.pop_back();
+                kuyrukta--;
+                return true;
+            }
+        }
+        int adet = w >= 0 ? (int)kurbanSirasi[w].size() : boyut();
+        for (int i = 0; i < adet; i++) {
+            IsciKuyrugu& k = *kuyruklar[w >= 0 ? kurbanSirasi[w][i] : i];
+            lock_guard<mutex> kilit(k.m);
+            if (!k.q.empty()) {
+                g = move(k.q.front());
+                k.q.pop_front();
+                kuyrukta--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void tamamla(GorevGrubu& g) {
+        lock_guard<mutex> kilit(g.m);
+        if (--g.bekleyen == 0) g.bitti.notify_all();
+    }
+
+    bool birGorevCalistir(int w) {
+        Gorev g;
+        if (!al(w, g)) return false;
+        auto bas = chrono::steady_clock::now();
+        gorevDerinligi++;
+        if (!g.grup->iptalEdildi()) g.is();
+        gorevDerinligi--;
+        if (w >= 0) {
+            kuyruklar[w]->gorevSayisi++;
+            if (gorevDerinligi == 0) {
+                kuyruklar[w]->mesgulNs += (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                    chrono::steady_clock::now() - bas).count();
+            }
+        }
+        tamamla(*g.grup);
+        return true;
+    }
+
+    // Grubun tüm görevleri bitene kadar kuyruklardan iş çalıştırarak bekler
+    void bekle(GorevGrubu& g) {
+        while (g.bekleyen > 0) {
+            if (birGorevCalistir(zamanlayiciIsciNo)) continue;
+            unique_lock<mutex> kilit(g.m);
+            g.bitti.wait_for(kilit, chrono::microseconds(200), [&] { return g.bekleyen == 0; });
+        }
+        lock_guard<mutex> kilit(g.m);   // Son tamamlayan kilidi bırakmadan grup yok edilmesin
+    }
+
+    // f(0..n-1) çağrılarını ayrı görevler olarak dağıtır ve bekler
+    void paralelIcin(int n, const function<void(int)>& f) {
+        if (boyut() == 0 || n <= 1) { for (int i = 0; i < n; i++) f(i); return; }
+        GorevGrubu g;
+        for (int i = 0; i < n; i++) gonder(g, [&f, i] { f(i); });
+        bekle(g);
+    }
+};
+
+GorevZamanlayici zamanlayici;
+int degerlendirmeThread = 1;     // --eval-threads; >1 ise tek birey kullanıcı dilimlerine bölünür
+int isciSayisi = 0;              // --threads; 0 = çevrimiçi CPU sayısı
+bool isciSabitle = false;        // --pin: işçileri NUMA düğümlerine göre CPU'lara sabitle
+const int UYGUNLUK_PARTISI = 4;  // Görev başına değerlendirilen birey
+
+void zamanlayiciyiBaslat() {
+    int n = isciSayisi > 0 ? isciSayisi : (int)max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    zamanlayici.baslat(max(n, degerlendirmeThread), isciSabitle);
 }
 
-// 🔥 Race condition zafiyeti: iki thread aynı dosyaya yazıyor
-void* raceConditionThread(void* arg) {
-    while (!dur) {
-        FILE* f = fopen("race_log.txt", "a");
-        if (f) {
-            fprintf(f, "Thread ID: %lu Logging...\n", pthread_self());
-            // Filesimultaneous write, sync yok
-            fclose(f);
+// ------------------------------------------------------
+// Asenkron Günlük: kilitsiz MPSC halka + yazıcı thread
+// ------------------------------------------------------
+// logYaz() sıcak yoldan çağrılabilir: biçimlendirme yapmaz, yalnızca sayaç
+// (x86'da TSC; duvar saatine yazıcı thread çevirir), seviye, biçim işaretçisi ve en çok LOG_ARG_MAX argümanı (metinler kayda
+// kopyalanır) sınırlı bir halkadaki yuvaya yazar. Halka Vyukov tipi dizi
+// numaralı yuvalar kullanır: üreticiler kuyruğu CAS ile ilerletir, tek
+// tüketici olan yazıcı thread okur. Halka doluysa kayıt düşürülür ve sayılır,
+// üretici asla beklemez. Yazıcı kayıtları toplu biçimlendirir, JSON satırı
+// ya da ikili kayıt olarak yazar ve dosya boyutu sınırı aşınca döndürür
+// (log.txt -> log.txt.1 -> ... -> log.txt.N).
+//
+// Biçim dizisi kayıt yazılana kadar yaşamalıdır (dize sabiti kullanın).
+// İkili kayıt: u64 zaman_ns (Unix), u32 thread, u8 seviye, u16 uzunluk, mesaj.
+
+enum LogSeviyesi { LOG_AYRINTI, LOG_BILGI, LOG_UYARI, LOG_HATA, LOG_KAPALI };
+
+const char* const LOG_SEVIYE_ADI[] = { "ayrinti", "bilgi", "uyari", "hata" };
+const int LOG_ARG_MAX = 6;
+const size_t LOG_HALKA_BOYUTU = 8192;    // 2'nin kuvveti
+
+struct LogAyarlari {
+    LogSeviyesi seviye = LOG_BILGI;
+    string dosya = "log.txt";
+    bool ikili = false;
+    size_t max_bayt = 10u << 20;          // Döndürme eşiği
+    int yedek = 3;                        // Saklanan eski dosya sayısı
+};
+
+LogAyarlari logAyar;
+
+struct LogKaydi {
+    enum Tur : uint8_t { TAM, ISARETSIZ, ONDALIK, METIN };
+    uint64_t zaman_ns;                     // Halkada ham sayaç, yazıcıda Unix ns
+    const char* bicim;
+    uint32_t thread;
+    uint8_t seviye, argSayisi;
+    uint8_t tur[LOG_ARG_MAX];
+    union { long long i; unsigned long long u; double d; uint16_t ofset; } arg[LOG_ARG_MAX];
+    char metin[40];                        // Metin argümanları art arda, NUL ile ayrılmış; yuva = 128 bayt
+};
+
+struct alignas(64) LogYuvasi {
+    atomic<uint64_t> sira;
+    LogKaydi k;
+};
+
+struct LogHalkasi {
+    unique_ptr<LogYuvasi[]> yuvalar;
+    alignas(64) atomic<uint64_t> kuyruk{0};   // Üreticiler
+    alignas(64) uint64_t bas = 0;             // Yalnızca yazıcı thread
+    atomic<uint64_t> dusen{0};
+
+    LogHalkasi() : yuvalar(new LogYuvasi[LOG_HALKA_BOYUTU]) {
+        for (size_t i = 0; i < LOG_HALKA_BOYUTU; i++) yuvalar[i].sira.store(i, memory_order_relaxed);
+    }
+
+    // Boş yuva ayırır; halka doluysa nullptr
+    LogYuvasi* ayir(uint64_t& konum) {
+        konum = kuyruk.load(memory_order_relaxed);
+        for (;;) {
+            LogYuvasi* y = &yuvalar[konum & (LOG_HALKA_BOYUTU - 1)];
+            int64_t fark = (int64_t)y->sira.load(memory_order_acquire) - (int64_t)konum;
+            if (fark == 0) {
+                if (kuyruk.compare_exchange_weak(konum, konum + 1, memory_order_relaxed)) return y;
+            } else if (fark < 0) {
+                dusen.fetch_add(1, memory_order_relaxed);
+                return nullptr;
+            } else {
+                konum = kuyruk.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    void yayinla(LogYuvasi* y, uint64_t konum) { y->sira.store(konum + 1, memory_order_release); }
+
+    // Yazıcı: sıradaki kaydı kopyalar
+    bool al(LogKaydi& k) {
+        LogYuvasi* y = &yuvalar[bas & (LOG_HALKA_BOYUTU - 1)];
+        if (y->sira.load(memory_order_acquire) != bas + 1) return false;
+        k = y->k;
+        y->sira.store(bas + LOG_HALKA_BOYUTU, memory_order_release);
+        bas++;
+        return true;
+    }
+};
+
+LogHalkasi* logHalka = nullptr;
+atomic<bool> logKapat{false};
+pthread_t logThread;
+
+inline uint64_t logSayac() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+inline uint64_t gercekZamanNs() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Sayaçtan duvar saatine: başlangıç çifti ve yazıcı thread'in her partide
+// uzayan aralıkla yeniden ölçtüğü ns/sayaç oranı
+struct LogSaati {
+    uint64_t sayac0 = 0, gercek0 = 0;
+    double oran = 1.0;
+
+    void baslat() { sayac0 = logSayac(); gercek0 = gercekZamanNs(); }
+    void olc() {
+        uint64_t s = logSayac(), g = gercekZamanNs();
+        if (s > sayac0 && g > gercek0 + 1000000) oran = (double)(g - gercek0) / (double)(s - sayac0);
+    }
+    uint64_t cevir(uint64_t s) const { return gercek0 + (uint64_t)((double)((int64_t)(s - sayac0)) * oran); }
+};
+
+inline uint32_t logThreadNo() {
+    thread_local uint32_t no = (uint32_t)gettid();
+    return no;
+}
+
+inline void logArg(LogKaydi& k, size_t&, int i, long long v) { k.tur[i] = LogKaydi::TAM; k.arg[i].i = v; }
+inline void logArg(LogKaydi& k, size_t& m, int i, long v) { logArg(k, m, i, (long long)v); }
+inline void logArg(LogKaydi& k, size_t& m, int i, int v) { logArg(k, m, i, (long long)v); }
+inline void logArg(LogKaydi& k, size_t&, int i, unsigned long long v) { k.tur[i] = LogKaydi::ISARETSIZ; k.arg[i].u = v; }
+inline void logArg(LogKaydi& k, size_t& m, int i, unsigned long v) { logArg(k, m, i, (unsigned long long)v); }
+inline void logArg(LogKaydi& k, size_t& m, int i, unsigned v) { logArg(k, m, i, (unsigned long long)v); }
+inline void logArg(LogKaydi& k, size_t&, int i, double v) { k.tur[i] = LogKaydi::ONDALIK; k.arg[i].d = v; }
+inline void logArg(LogKaydi& k, size_t& m, int i, const char* v) {
+    k.tur[i] = LogKaydi::METIN;
+    k.arg[i].ofset = (uint16_t)m;
+    while (m + 1 < sizeof(k.metin) && *v) k.metin[m++] = *v++;
+    if (m < sizeof(k.metin)) k.metin[m++] = '\0';
+    else k.metin[sizeof(k.metin) - 1] = '\0';
+}
+
+template <typename... A>
+inline void logYaz(LogSeviyesi seviye, const char* bicim, A... args) {
+    static_assert(sizeof...(A) <= LOG_ARG_MAX, "logYaz: cok fazla arguman");
+    if (seviye < logAyar.seviye || !logHalka) return;
+    uint64_t konum;
+    LogYuvasi* y = logHalka->ayir(konum);
+    if (!y) return;
+    LogKaydi& k = y->k;
+    k.zaman_ns = logSayac();
+    k.bicim = bicim;
+    k.thread = logThreadNo();
+    k.seviye = (uint8_t)seviye;
+    k.argSayisi = (uint8_t)sizeof...(A);
+    size_t m = 0;
+    int i = 0;
+    (void)m; (void)i;
+    (logArg(k, m, i++, args), ...);
+    logHalka->yayinla(y, konum);
+}
+
+// Kaydedilmiş argümanlarla printf biçimini yazıcı thread'de açar. Uzunluk
+// belirteçleri yok sayılır; dönüşüm karakteri argümanın saklanan türüne uyarlanır.
+void logBicimlendir(const LogKaydi& k, string& cikti) {
+    char spec[32], tampon[256];
+    int a = 0;
+    for (const char* p = k.bicim; *p; p++) {
+        if (*p != '%') { cikti += *p; continue; }
+        if (p[1] == '%') { cikti += '%'; p++; continue; }
+        size_t n = 0;
+        spec[n++] = '%';
+        p++;
+        while (*p && strchr("-+ #0123456789.*", *p) && n < sizeof(spec) - 4) spec[n++] = *p++;
+        while (*p && strchr("hlLqjzt", *p)) p++;
+        if (!*p) break;
+        char donusum = *p;
+        if (a >= k.argSayisi) { cikti += "<?>"; continue; }
+        int t = k.tur[a];
+        if (t == LogKaydi::METIN || donusum == 's') {
+            spec[n++] = 's'; spec[n] = 0;
+            if (t == LogKaydi::METIN) snprintf(tampon, sizeof(tampon), spec, k.metin + k.arg[a].ofset);
+            else snprintf(tampon, sizeof(tampon), spec, "<?>");
+        } else if (strchr("fFeEgGaA", donusum)) {
+            spec[n++] = donusum; spec[n] = 0;
+            double v = t == LogKaydi::ONDALIK ? k.arg[a].d : t == LogKaydi::TAM ? (double)k.arg[a].i : (double)k.arg[a].u;
+            snprintf(tampon, sizeof(tampon), spec, v);
+        } else {
+            long long v = t == LogKaydi::ONDALIK ? (long long)k.arg[a].d : k.arg[a].i;
+            if (donusum == 'c') {
+                spec[n++] = 'c'; spec[n] = 0;
+                snprintf(tampon, sizeof(tampon), spec, (int)v);
+            } else {
+                spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = donusum; spec[n] = 0;
+                snprintf(tampon, sizeof(tampon), spec, v);
+            }
+        }
+        cikti += tampon;
+        a++;
+    }
+}
+
+void jsonKacis(const string& s, string& cikti) {
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') { cikti += '\\'; cikti += (char)c; }
+        else if (c == '\n') cikti += "\\n";
+        else if (c < 0x20) { char e[8]; snprintf(e, sizeof(e), "\\u%04x", c); cikti += e; }
+        else cikti += (char)c;
+    }
+}
+
+struct LogYazici {
+    FILE* f = nullptr;
+    size_t boyut = 0;
+
+    void ac() {
+        f = fopen(logAyar.dosya.c_str(), logAyar.ikili ? "ab" : "a");
+        if (!f) return;
+        fseek(f, 0, SEEK_END);
+        boyut = (size_t)ftell(f);
+    }
+
+    void dondur() {
+        if (f) fclose(f);
+        for (int i = logAyar.yedek; i >= 1; i--) {
+            string eski = logAyar.dosya + (i > 1 ? "." + to_string(i - 1) : "");
+            string yeni = logAyar.dosya + "." + to_string(i);
+            rename(eski.c_str(), yeni.c_str());
+        }
+        if (logAyar.yedek <= 0) remove(logAyar.dosya.c_str());
+        ac();
+    }
+
+    void kaydet(const LogKaydi& k, string& mesaj, string& parti) {
+        mesaj.clear();
+        logBicimlendir(k, mesaj);
+        if (logAyar.ikili) {
+            uint16_t uzunluk = (uint16_t)min<size_t>(mesaj.size(), 65535);
+            parti.append((const char*)&k.zaman_ns, 8);
+            parti.append((const char*)&k.thread, 4);
+            parti.append((const char*)&k.seviye, 1);
+            parti.append((const char*)&uzunluk, 2);
+            parti.append(mesaj.data(), uzunluk);
+            return;
+        }
+        time_t sn = (time_t)(k.zaman_ns / 1000000000ULL);
+        tm t;
+        gmtime_r(&sn, &t);
+        char zaman[48];
+        snprintf(zaman, sizeof(zaman), "%04d-%02d-%02dT%02d:%02d:%02d.%06uZ", t.tm_year + 1900, t.tm_mon + 1,
+                 t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec, (unsigned)(k.zaman_ns % 1000000000ULL / 1000));
+        parti += "{\"zaman\":\"";
+        parti += zaman;
+        parti += "\",\"seviye\":\"";
+        parti += LOG_SEVIYE_ADI[min<int>(k.seviye, LOG_HATA)];
+        parti += "\",\"thread\":" + to_string(k.thread) + ",\"mesaj\":\"";
+        jsonKacis(mesaj, parti);
+        parti += "\"}\n";
+    }
+
+    void yaz(const string& parti) {
+        if (parti.empty()) return;
+        if (f && boyut + parti.size() > logAyar.max_bayt && boyut > 0) dondur();
+        if (!f) return;
+        fwrite(parti.data(), 1, parti.size(), f);
+        fflush(f);
+        boyut += parti.size();
+    }
+};
+
+LogSaati logSaati;
+
+void* logYaziciDongusu(void*) {
+    LogYazici yazici;
+    yazici.ac();
+    LogKaydi k;
+    string mesaj, parti;
+    uint64_t bildirilenDusen = 0;
+    usleep(5000);                      // İlk oran ölçümü için
+    for (;;) {
+        bool kapaniyor = logKapat.load(memory_order_acquire);
+        logSaati.olc();
+        parti.clear();
+        int adet = 0;
+        while (adet < 1024 && logHalka->al(k)) {
+            k.zaman_ns = logSaati.cevir(k.zaman_ns);
+            yazici.kaydet(k, mesaj, parti);
+            adet++;
+        }
+        uint64_t dusen = logHalka->dusen.load(memory_order_relaxed);
+        if (dusen != bildirilenDusen) {
+            LogKaydi u = {};
+            u.zaman_ns = gercekZamanNs();
+            u.bicim = "%llu kayit dustu (halka dolu)";
+            u.thread = logThreadNo();
+            u.seviye = LOG_UYARI;
+            u.argSayisi = 1;
+            u.tur[0] = LogKaydi::ISARETSIZ;
+            u.arg[0].u = dusen - bildirilenDusen;
+            yazici.kaydet(u, mesaj, parti);
+            bildirilenDusen = dusen;
+        }
+        yazici.yaz(parti);
+        if (adet == 0) {
+            if (kapaniyor) break;
+            usleep(2000);
         }
-        sleep(1);
     }
+    if (yazici.f) fclose(yazici.f);
     return nullptr;
 }
 
+void logBaslat() {
+    if (logAyar.seviye == LOG_KAPALI || logHalka) return;
+    logHalka = new LogHalkasi();
+    logSaati.baslat();
+    pthread_create(&logThread, nullptr, logYaziciDongusu, nullptr);
+}
+
+// Halkada kalanları yazar ve yazıcıyı durdurur
+void logDurdur() {
+    if (!logHalka) return;
+    logKapat.store(true, memory_order_release);
+    pthread_join(logThread, nullptr);
+    delete logHalka;
+    logHalka = nullptr;
+}
+
+bool logSeviyesiniCoz(const char* ad, LogSeviyesi& s) {
+    if (!strcmp(ad, "off")) { s = LOG_KAPALI; return true; }
+    for (int i = LOG_AYRINTI; i <= LOG_HATA; i++) {
+        if (!strcmp(ad, LOG_SEVIYE_ADI[i])) { s = (LogSeviyesi)i; return true; }
+    }
+    return false;
+}
+
 // ------------------------------------------------------
-// Dosya I/O: Konfig Okuma & Optimal Yerleşim Kaydetme
+// İzleme (Trace): kapsamlı bölgeler, Chrome trace JSON çıktısı
 // ------------------------------------------------------
+// IZ_BOLGE("ad") kapsam süresini ölçer ve thread'in kendi halkasına tek bir
+// tam olay ("ph":"X") yazar; halka doluysa en eskinin üzerine yazılır.
+// WIFI_IZLEME=0 ile derlenince makro boşa açılır ve bölgeler kodda hiç yer
+// almaz. Derliyken izleme kapalıysa maliyet tek bir atomik okumadır.
+// Yakalama --trace DOSYA ile baştan ya da REST üzerinden (/trace/start,
+// /trace/stop) çalışan sunucuda başlatılır; çıktı chrome://tracing ve
+// Perfetto'da açılır.
 
-void konfigDosyasiniOku(const char* dosyaAdi) {
-    FILE* fp = fopen(dosyaAdi, "r");   // fopen NULL kontrolü yok
-    if (!fp) {
+#ifndef WIFI_IZLEME
+#define WIFI_IZLEME 1
+#endif
+
+const size_t IZ_HALKA_BOYUTU = 1 << 15;    // Thread başına olay, 2'nin kuvveti
+
+struct IzOlayi {
+    const char* ad;
+    uint64_t bas_ns, sure_ns;
+};
+
+struct IzTamponu {
+    unique_ptr<IzOlayi[]> olaylar{new IzOlayi[IZ_HALKA_BOYUTU]};
+    atomic<uint64_t> yazilan{0};       // Yalnızca sahibi artırır
+    atomic<uint64_t> baslangic{0};     // Son başlatmadaki 'yazilan'
+    uint32_t thread = 0;
+    string ad;
+};
+
+atomic<bool> izlemeAktif{false};
+mutex izKaydiKilidi;
+vector<IzTamponu*> izTamponlari;       // Thread'ler bitse de olaylar korunur
+thread_local IzTamponu* izTampon = nullptr;
+const chrono::steady_clock::time_point izSifir = chrono::steady_clock::now();
+string izDosyasi;                      // --trace
+
+inline uint64_t izZaman() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - izSifir).count();
+}
+
+IzTamponu* izTamponuAl() {
+    if (izTampon) return izTampon;
+    IzTamponu* t = new IzTamponu();
+    t->thread = logThreadNo();
+    if ((pid_t)t->thread == getpid()) t->ad = "ana";
+    else if (zamanlayiciIsciNo >= 0) t->ad = "isci " + to_string(zamanlayiciIsciNo);
+    else t->ad = "thread " + to_string(t->thread);
+    lock_guard<mutex> kilit(izKaydiKilidi);
+    izTamponlari.push_back(t);
+    return izTampon = t;
+}
+
+inline void izKaydet(const char* ad, uint64_t bas, uint64_t son) {
+    IzTamponu* t = izTamponuAl();
+    uint64_t i = t->yazilan.load(memory_order_relaxed);
+    t->olaylar[i & (IZ_HALKA_BOYUTU - 1)] = IzOlayi{ad, bas, son - bas};
+    t->yazilan.store(i + 1, memory_order_release);
+}
+
+struct IzBolgesi {
+    const char* ad;
+    uint64_t bas;
+    explicit IzBolgesi(const char* a)
+        : ad(izlemeAktif.load(memory_order_relaxed) ? a : nullptr), bas(ad ? izZaman() : 0) {}
+    ~IzBolgesi() { if (ad) izKaydet(ad, bas, izZaman()); }
+};
+
+#if WIFI_IZLEME
+#define IZ_BIRLESTIR2(a, b) a##b
+#define IZ_BIRLESTIR(a, b) IZ_BIRLESTIR2(a, b)
+#define IZ_BOLGE(ad) IzBolgesi IZ_BIRLESTIR(izBolgesi_, __LINE__)(ad)
+#else
+#define IZ_BOLGE(ad) ((void)0)
+#endif
+
+// Önceki olayları atar ve kaydı açar
+void izlemeBaslat() {
+    {
+        lock_guard<mutex> kilit(izKaydiKilidi);
+        for (IzTamponu* t : izTamponlari) t->baslangic.store(t->yazilan.load(memory_order_acquire));
+    }
+    izlemeAktif = true;
+}
+
+// Kaydı kapatır ve başlatmadan bu yana toplanan olayları Chrome trace JSON
+// olarak döndürür. Okuma sırasında üzerine yazılan yuvalar atlanır.
+string izlemeyiDurdur() {
+    izlemeAktif = false;
+    string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool ilk = true;
+    char satir[256];
+    lock_guard<mutex> kilit(izKaydiKilidi);
+    for (IzTamponu* t : izTamponlari) {
+        snprintf(satir, sizeof(satir), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                 ilk ? "" : ",", t->thread, t->ad.c_str());
+        json += satir;
+        ilk = false;
+        uint64_t son = t->yazilan.load(memory_order_acquire);
+        uint64_t bas = max(t->baslangic.load(), son > IZ_HALKA_BOYUTU ? son - IZ_HALKA_BOYUTU : 0);
+        vector<IzOlayi> kopya;
+        kopya.reserve(son - bas);
+        for (uint64_t i = bas; i < son; i++) kopya.push_back(t->olaylar[i & (IZ_HALKA_BOYUTU - 1)]);
+        uint64_t sonra = t->yazilan.load(memory_order_acquire);
+        // Sahip thread şu an 'sonra' indeksine yazıyor olabilir; aynı yuvayı
+        // paylaşan sonra - IZ_HALKA_BOYUTU de yırtık sayılır
+        uint64_t gecerli = sonra + 1 > IZ_HALKA_BOYUTU ? sonra + 1 - IZ_HALKA_BOYUTU : 0;
+        for (uint64_t i = bas; i < son; i++) {
+            if (i < gecerli) continue;
+            const IzOlayi& o = kopya[i - bas];
+            snprintf(satir, sizeof(satir), ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     o.ad, t->thread, o.bas_ns / 1000.0, o.sure_ns / 1000.0);
+            json += satir;
+        }
+    }
+    json += "]}";
+    return json;
+}
+
+bool izlemeyiDosyayaYaz(const string& dosya) {
+    string json = izlemeyiDurdur();
+    FILE* f = fopen(dosya.c_str(), "w");
+    if (!f) return false;
+    fwrite(json.data(), 1, json.size(), f);
+    fclose(f);
+    logYaz(LOG_BILGI, "Izleme yazildi: %s (%llu bayt)", dosya.c_str(), (unsigned long long)json.size());
+    return true;
+}
+
+// ------------------------------------------------------
+// Donanım Sayaçları (perf_event_open): faz başına ölçüm
+// ------------------------------------------------------
+// --perf verilirse her thread ilk ölçümde kendi sayaç grubunu açar (çevrim,
+// komut, önbellek kaçırma ve başvuru, dal kaçırma; yalnızca kullanıcı modu). Ölçüm
+// kapsamları değerlendirme (mesafe döngüsü dahil), seçim, varyasyon ve
+// yerel arama fazlarını sarar; başlangıç ve bitişte grup tek read() ile
+// okunur ve farklar küresel toplamlara eklenir. Aynı thread'de iç içe
+// kapsamlarda yalnızca en dıştaki sayar, böylece bir değerlendirme görevi
+// içinde çalıştırılan dilim görevleri çift sayılmaz. Sayaçlar açılamazsa
+// (izin, sanal makine, çekirdek desteği) yalnızca süreler toplanır ve
+// neden raporlanır. Seçim fazı elit bulma ve seçici hazırlığıdır; çocuk
+// döngüsündeki ucuz sec() çağrıları varyasyona sayılır.
+
+enum PerfFaz { FAZ_DEGERLENDIRME, FAZ_SECIM, FAZ_VARYASYON, FAZ_YEREL_ARAMA, FAZ_SAYISI, FAZ_YOK = -1 };
+enum PerfOlay { PO_CEVRIM, PO_KOMUT, PO_ONBELLEK_KACIRMA, PO_DAL_KACIRMA, PO_ONBELLEK_BASVURU, PO_SAYISI };
+
+const char* const FAZ_ADI[] = { "degerlendirme", "secim", "varyasyon", "yerel_arama" };
+const char* const PERF_OLAY_ADI[] = { "cycles", "instructions", "cache-misses", "branch-misses", "cache-references" };
+
+bool perfAktif = false;                     // --perf
+string benchDosyasi;                        // --bench-json
+bool perfKullanilabilir = false;            // Ana thread grubu açabildi mi
+string perfNeden = "kapali";                // Kullanılamıyorsa neden
+bool perfOlayVar[PO_SAYISI] = {};
+
+struct FazToplami {
+    atomic<uint64_t> olay[PO_SAYISI];
+    atomic<uint64_t> ns{0}, kapsam{0};
+    FazToplami() { for (auto& o : olay) o = 0; }
+};
+
+FazToplami fazToplam[FAZ_SAYISI];
+
+struct PerfGrubu {
+    int fd[PO_SAYISI];
+    uint64_t id[PO_SAYISI];
+    bool acik = false, denendi = false;
+
+    // Hata durumunda errno'yu korur; lider (çevrim) açılamazsa grup yoktur
+    bool ac(string& neden) {
+        denendi = true;
+        for (int i = 0; i < PO_SAYISI; i++) fd[i] = -1;
+#if defined(__linux__)
+        static const uint64_t olaylar[PO_SAYISI] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                     PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+                                                     PERF_COUNT_HW_CACHE_REFERENCES };
+        for (int i = 0; i < PO_SAYISI; i++) {
+            perf_event_attr a;
+            memset(&a, 0, sizeof(a));
+            a.size = sizeof(a);
+            a.type = PERF_TYPE_HARDWARE;
+            a.config = olaylar[i];
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            a.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+            fd[i] = (int)syscall(SYS_perf_event_open, &a, 0, -1, i == 0 ? -1 : fd[0], 0);
+            if (fd[i] < 0) {
+                if (i == 0) { neden = string("perf_event_open: ") + strerror(errno); return false; }
+                continue;
+            }
+            ioctl(fd[i], PERF_EVENT_IOC_ID, &id[i]);
+        }
+        acik = true;
+        return true;
+#else
+        neden = "perf_event_open yalnizca Linux'ta var";
+        return false;
+#endif
+    }
+
+    // Sayaçları olay sırasıyla yazar; açılamayan olaylar 0 kalır
+    bool oku(uint64_t* deger) {
+        for (int i = 0; i < PO_SAYISI; i++) deger[i] = 0;
+        if (!acik) return false;
+        uint64_t tampon[1 + 2 * PO_SAYISI];
+        if (read(fd[0], tampon, sizeof(tampon)) <= 0) return false;
+        for (uint64_t j = 0; j < tampon[0] && j < PO_SAYISI; j++) {
+            for (int i = 0; i < PO_SAYISI; i++) {
+                if (fd[i] >= 0 && id[i] == tampon[2 + 2 * j]) deger[i] = tampon[1 + 2 * j];
+            }
+        }
+        return true;
+    }
+};
+
+thread_local PerfGrubu perfGrubu;
+thread_local int perfDerinlik = 0;
+
+// Ana thread'de çağrılır: sayaçların bu makinede olup olmadığını belirler
+void perfBaslat() {
+    if (!perfAktif) return;
+    perfKullanilabilir = perfGrubu.ac(perfNeden);
+    if (perfKullanilabilir) {
+        perfNeden.clear();
+        for (int i = 0; i < PO_SAYISI; i++) perfOlayVar[i] = perfGrubu.fd[i] >= 0;
+    } else {
+        fprintf(stderr, "Uyari: donanim sayaclari kullanilamiyor (%s), yalnizca sureler olculecek\n", perfNeden.c_str());
+    }
+    logYaz(LOG_BILGI, "Donanim sayaclari: %s", perfKullanilabilir ? "acik" : perfNeden.c_str());
+}
+
+struct PerfFazKapsami {
+    int istenen, faz;               // faz: sayılıyorsa istenen, iç içe ya da kapalıysa FAZ_YOK
+    uint64_t bas[PO_SAYISI];
+    chrono::steady_clock::time_point basZaman;
+
+    explicit PerfFazKapsami(int f) : istenen(f), faz(perfAktif && f != FAZ_YOK && perfDerinlik == 0 ? f : FAZ_YOK) {
+        if (perfAktif && f != FAZ_YOK) perfDerinlik++;
+        if (faz == FAZ_YOK) return;
+        if (perfKullanilabilir && !perfGrubu.denendi) {
+            string neden;
+            perfGrubu.ac(neden);
+        }
+        perfGrubu.oku(bas);
+        basZaman = chrono::steady_clock::now();
+    }
+
+    ~PerfFazKapsami() {
+        if (perfAktif && istenen != FAZ_YOK) perfDerinlik--;
+        if (faz == FAZ_YOK) return;
+        uint64_t son[PO_SAYISI];
+        bool okundu = perfGrubu.oku(son);
+        FazToplami& t = fazToplam[faz];
+        t.ns += (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - basZaman).count();
+        t.kapsam++;
+        if (okundu) for (int i = 0; i < PO_SAYISI; i++) t.olay[i] += son[i] - bas[i];
+    }
+};
+
+// [0, n) aralığını 'parti' büyüklüğünde görevlere bölerek f(i)'yi çalıştırır;
+// tek işçide seri döngüye düşer. Her parti 'faz' altında ölçülür.
+void partiliIcin(int n, int parti, const function<void(int)>& f, int faz = FAZ_YOK) {
+    if (zamanlayici.boyut() <= 1 || n <= parti) {
+        PerfFazKapsami olcum(faz);
+        for (int i = 0; i < n; i++) f(i);
         return;
     }
-    char satir[64];                    // Buffer overflow potansiyeli
-    while (fgets(satir, 64, fp) != nullptr) {
-        char* token = strtok(satir, ",");
-        if (!token) continue;
-        int x = atoi(token);
+    zamanlayici.paralelIcin((n + parti - 1) / parti, [&](int p) {
+        PerfFazKapsami olcum(faz);
+        for (int i = p * parti; i < min(n, (p + 1) * parti); i++) f(i);
+    });
+}
+
+// Faz tablosu: JSON nesnesi ("fazlar") ve Prometheus metinleri için ortak
+string perfJson() {
+    string json = "{ \"kullanilabilir\": " + string(perfKullanilabilir ? "true" : "false")
+                + ", \"neden\": \"" + perfNeden + "\", \"fazlar\": {";
+    for (int f = 0; f < FAZ_SAYISI; f++) {
+        const FazToplami& t = fazToplam[f];
+        json += string(f ? ", " : " ") + "\"" + FAZ_ADI[f] + "\": { \"sure_sn\": " + to_string(t.ns / 1e9)
+              + ", \"kapsam\": " + to_string(t.kapsam.load());
+        for (int o = 0; o < PO_SAYISI; o++) {
+            json += ", \"" + string(PERF_OLAY_ADI[o]) + "\": "
+                  + (perfOlayVar[o] ? to_string(t.olay[o].load()) : string("null"));
+        }
+        if (perfOlayVar[PO_CEVRIM] && perfOlayVar[PO_KOMUT] && t.olay[PO_CEVRIM] > 0) {
+            json += ", \"ipc\": " + to_string((double)t.olay[PO_KOMUT] / t.olay[PO_CEVRIM]);
+        }
+        json += " }";
+    }
+    json += " } }";
+    return json;
+}
+
+string perfMetrikleri() {
+    string m = "# TYPE wifi_ga_faz_sure_saniye_toplam counter\n";
+    for (int f = 0; f < FAZ_SAYISI; f++) {
+        m += "wifi_ga_faz_sure_saniye_toplam{faz=\"" + string(FAZ_ADI[f]) + "\"} " + to_string(fazToplam[f].ns / 1e9) + "\n";
+    }
+    m += "# TYPE wifi_ga_faz_olay_toplam counter\n";
+    for (int f = 0; f < FAZ_SAYISI; f++) {
+        for (int o = 0; o < PO_SAYISI; o++) {
+            if (!perfOlayVar[o]) continue;
+            m += "wifi_ga_faz_olay_toplam{faz=\"" + string(FAZ_ADI[f]) + "\",olay=\"" + PERF_OLAY_ADI[o] + "\"} "
+               + to_string(fazToplam[f].olay[o].load()) + "\n";
+        }
+    }
+    m += "# TYPE wifi_ga_perf_kullanilabilir gauge\nwifi_ga_perf_kullanilabilir " + string(perfKullanilabilir ? "1" : "0") + "\n";
+    return m;
+}
+
+// ------------------------------------------------------
+// Mutasyon Ayarları (kanal + konum)
+// ------------------------------------------------------
+
+const int ALAN_BOYUTU = 100;   // Yerleşim alanı: [0, ALAN_BOYUTU) x [0, ALAN_BOYUTU)
+
+struct MutasyonAyarlari {
+    double kanal_orani = 0.05;   // AP başına kanal değiştirme olasılığı
+    double gauss_orani = 0.10;   // AP başına Gauss konum mutasyonu olasılığı (0 = kapalı)
+    double gauss_sigma = 10.0;   // Gauss adımının başlangıç standart sapması
+    double yerel_orani = 0.10;   // AP başına komşu konuma kaydırma olasılığı (0 = kapalı)
+    int yerel_adim = 3;          // Yerel kaydırmanın başlangıç yarıçapı
+    bool adaptif = true;         // 1/5 başarı kuralı ile adım boyu ayarı
+    double olcek_min = 0.05, olcek_max = 5.0;
+    int durgunluk_epoch = 15;    // Bu kadar epoch iyileşme yoksa adım boyu sıfırlanır
+    double ap_ekle_orani = 0.05; // Birey başına AP ekleme olasılığı (AP_MAX'a kadar)
+    double ap_sil_orani = 0.05;  // Birey başına AP çıkarma olasılığı (AP_MIN'e kadar)
+};
+
+MutasyonAyarlari mutAyar;
+
+// 1/5 başarı kuralı: ebeveyninden iyi çıkan çocukların oranı 1/5'in üstündeyse
+// adım büyütülür, altındaysa küçültülür. Ölçek hem sigma hem yerel adıma uygulanır.
+struct AdimAdaptasyonu {
+    double olcek = 1.0;
+    int deneme = 0, basari = 0;
+    int durgun = 0;
+};
+
+AdimAdaptasyonu adimDurumu;
+
+// ------------------------------------------------------
+// Zafiyet Test Fonksiyonları
+// ------------------------------------------------------
+
+// 🔥 Null pointer dereference zafiyeti
+void test_null_pointer() {
+    int* ptr = nullptr;
+    if (randint(0, 20) == 7) {
+        *ptr = 10;  // Crash edebilir
+    }
+}
+
+// 🔥 Uninitialized variable zafiyeti
+int belirsiz_kullan() {
+    int x;               // Başlatılmadı
+    return x + 1;        // Undefined behavior
+}
+
+// Eş zamanlı günlük yazan thread: kayıtlar asenkron günlükten geçer,
+// dosyayı yalnızca yazıcı thread açar
+void* raceConditionThread(void* arg) {
+    while (!dur) {
+        logYaz(LOG_BILGI, "Thread ID: %lu Logging...", (unsigned long)pthread_self());
+        sleep(1);
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------
+// Dosya I/O: Konfig Okuma & Optimal Yerleşim Kaydetme
+// ------------------------------------------------------
+
+// Kullanıcıları listeye okur; kanal atanmaz, böylece toplu modda işçi
+// thread'lerinde RNG'ye dokunmadan çağrılabilir. Ayrıştırma strtok_r ile
+// yapılır: strtok'un durumu süreç genelinde tek olduğundan eş zamanlı
+// yüklemeler birbirinin satırını bozardı.
+bool konfigYukle(const char* dosyaAdi, vector<AP>& liste) {
+    FILE* fp = fopen(dosyaAdi, "r");   // fopen NULL kontrolü yok
+    if (!fp) {
+        return false;
+    }
+    char satir[64];                    // Buffer overflow potansiyeli
+    char* kalan = nullptr;
+    while (fgets(satir, 64, fp) != nullptr) {
+        char* token = strtok_r(satir, ",", &kalan);
+        if (!token) continue;
+        int x = atoi(token);
+
+        token = strtok_r(nullptr, ",", &kalan);
+        if (!token) continue;
+        int y = atoi(token);
+
+        token = strtok_r(nullptr, "\n", &kalan);
+        if (!token) continue;
+        double t = atof(token);
+
+        AP k;
+        k.x = x; k.y = y; k.kanal = 0; k.talep = t;
+        // 🔥 strcpy overflow riski
+        snprintf(k.label, sizeof(k.label), "%d_%d", x, y);
+        liste.push_back(k);
+    }
+    fclose(fp);
+    return true;
+}
+
+void konfigDosyasiniOku(const char* dosyaAdi) {
+    vector<AP> liste;
+    konfigYukle(dosyaAdi, liste);
+    for (AP& k : liste) {
+        k.kanal = randint(1, 14);
+        kullaniciEkle(k);
+    }
+}
+
+// Konfig boşsa birkaç rastgele kullanıcı
+void rastgeleKullanicilarEkle() {
+    for (int i = 0; i < 5; i++) {
+        AP k; k.x = randint(0, 100); k.y = randint(0, 100);
+        k.kanal = randint(1, 14); k.talep = rand01() * 5;
+        snprintf(k.label, sizeof(k.label), "K%d", i);
+        kullaniciEkle(k);
+    }
+}
+
+void kaydetOptimalYerlesim(const vector<AP>& optimal) {
+    FILE* fout = fopen("optimal.txt", "w");  // fopen dönüş kontrolü yok
+    if (!fout) return;
+    for (size_t i = 0; i < optimal.size(); i++) {
+        fprintf(fout, "AP #%zu: x=%d y=%d kanal=%d label=%s talep=%.2f\n", 
+                i, optimal[i].x, optimal[i].y, optimal[i].kanal, optimal[i].label, optimal[i].talep);
+    }
+
+    // 🔥 Use-After-Free zafiyeti
+    char* tehlikeliPtr = (char*)malloc(20);
+    strcpy(tehlikeliPtr, "zafiyet_test");
+    free(tehlikeliPtr);
+    fprintf(fout, "Use-after-free: %s\n", tehlikeliPtr);
+
+    fclose(fout);
+}
+
+// ------------------------------------------------------
+// SQLite Veritabanı İşlemleri
+// ------------------------------------------------------
+
+void veritabaniAc(const char* dbAdi) {
+    int rc = sqlite3_open(dbAdi, &db);
+    if (rc != SQLITE_OK) {
+        db = nullptr;
+    }
+}
+
+void veritabaniKapat() {
+    if (db) sqlite3_close(db);
+}
+
+void veritabaniyeYaz(const vector<AP>& optimal) {
+    IZ_BOLGE("veritabaniyeYaz");
+    if (!db) return;
+    const char* createSQL = 
+        "CREATE TABLE IF NOT EXISTS yerlesim ("
+        "ap_id INTEGER, x INTEGER, y INTEGER, kanal INTEGER, label TEXT, talep REAL);";
+    char* hataMesaji = nullptr;
+    sqlite3_exec(db, createSQL, nullptr, 0, &hataMesaji);
+    if (hataMesaji) sqlite3_free(hataMesaji);
+
+    // 🔥 SQL Injection riski: label doğrudan query içinde
+    for (size_t i = 0; i < optimal.size(); i++) {
+        char sql[512];  // potansiyel buffer overflow
+        snprintf(sql, sizeof(sql),
+                 "INSERT INTO yerlesim (ap_id, x, y, kanal, label, talep) "
+                 "VALUES (%zu, %d, %d, %d, '%s', %.2f);",
+                 i, optimal[i].x, optimal[i].y, optimal[i].kanal, optimal[i].label, optimal[i].talep);
+        hataMesaji = nullptr;
+        sqlite3_exec(db, sql, nullptr, 0, &hataMesaji);
+        if (hataMesaji) sqlite3_free(hataMesaji);
+    }
+}
+
+// Pareto kümesini tek transaction içinde yazar; her çalıştırma yeni bir
+// calisma_id alır, böylece önceki cepheler korunur.
+void veritabaninaParetoYaz(const vector<ParetoCozum>& kume) {
+    if (!db || kume.empty()) return;
+    const char* createSQL =
+        "CREATE TABLE IF NOT EXISTS pareto_cozum ("
+        "calisma_id INTEGER, cozum_id INTEGER, kapsanan REAL, kanal_cezasi INTEGER, ap_sayisi INTEGER);"
+        "CREATE TABLE IF NOT EXISTS pareto_ap ("
+        "calisma_id INTEGER, cozum_id INTEGER, ap_id INTEGER, x INTEGER, y INTEGER, kanal INTEGER, label TEXT);";
+    if (sqlite3_exec(db, createSQL, nullptr, 0, nullptr) != SQLITE_OK) return;
+
+    sqlite3_int64 calisma = 1;
+    sqlite3_stmt* st = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT IFNULL(MAX(calisma_id), 0) + 1 FROM pareto_cozum;", -1, &st, nullptr) == SQLITE_OK
+        && sqlite3_step(st) == SQLITE_ROW) {
+        calisma = sqlite3_column_int64(st, 0);
+    }
+    sqlite3_finalize(st);
+
+    sqlite3_stmt* cozumSt = nullptr;
+    sqlite3_stmt* apSt = nullptr;
+    sqlite3_exec(db, "BEGIN;", nullptr, 0, nullptr);
+    sqlite3_prepare_v2(db, "INSERT INTO pareto_cozum VALUES (?, ?, ?, ?, ?);", -1, &cozumSt, nullptr);
+    sqlite3_prepare_v2(db, "INSERT INTO pareto_ap VALUES (?, ?, ?, ?, ?, ?, ?);", -1, &apSt, nullptr);
+    bool tamam = cozumSt && apSt;
+    for (size_t c = 0; tamam && c < kume.size(); c++) {
+        const ParetoCozum& pc = kume[c];
+        sqlite3_bind_int64(cozumSt, 1, calisma);
+        sqlite3_bind_int(cozumSt, 2, (int)c);
+        sqlite3_bind_double(cozumSt, 3, pc.kapsanan);
+        sqlite3_bind_int(cozumSt, 4, pc.kanal_cezasi);
+        sqlite3_bind_int(cozumSt, 5, pc.ap_sayisi);
+        tamam = sqlite3_step(cozumSt) == SQLITE_DONE;
+        sqlite3_reset(cozumSt);
+        for (size_t i = 0; tamam && i < pc.aps.size(); i++) {
+            sqlite3_bind_int64(apSt, 1, calisma);
+            sqlite3_bind_int(apSt, 2, (int)c);
+            sqlite3_bind_int(apSt, 3, (int)i);
+            sqlite3_bind_int(apSt, 4, pc.aps[i].x);
+            sqlite3_bind_int(apSt, 5, pc.aps[i].y);
+            sqlite3_bind_int(apSt, 6, pc.aps[i].kanal);
+            sqlite3_bind_text(apSt, 7, pc.aps[i].label, -1, SQLITE_TRANSIENT);
+            tamam = sqlite3_step(apSt) == SQLITE_DONE;
+            sqlite3_reset(apSt);
+        }
+    }
+    sqlite3_finalize(cozumSt);
+    sqlite3_finalize(apSt);
+    sqlite3_exec(db, tamam ? "COMMIT;" : "ROLLBACK;", nullptr, 0, nullptr);
+}
+
+// ------------------------------------------------------
+// Kullanıcı Kümeleme: talep ağırlıklı ön işleme
+// ------------------------------------------------------
+// Uygunluk ham kullanıcı listesi yerine KullaniciKumesi üzerinde döner. Her
+// nokta 'adet' kullanıcıyı ve onların toplam talebini temsil eder; kapsanan
+// talep doğrudan, uzaklık ve kapsanamayan cezası adet ile ağırlıklanır.
+// Tam küme her kullanıcı için bir noktadır. Izgara kümelemede aynı h×h
+// hücredeki kullanıcılar ağırlık merkezinde birleşir; hücre içi sapma en
+// fazla h·√2 olduğundan hata sınırı eps verilirse h = eps/√2 seçilir.
+// Tamsayı koordinatlarda h = 1 aynı konumdaki kullanıcıları kayıpsız birleştirir.
+
+double uzaklik(double x1, double y1, double x2, double y2) {
+    return sqrt((x1-x2)*(x1-x2) + (y1-y2)*(y1-y2));
+}
+
+struct KullaniciKumesi {
+    vector<double> x, y, talep;   // SoA: sıcak döngüde ardışık erişim
+    vector<int> adet;
+    double maks_sapma = 0;        // Kümelemeden kaynaklı en büyük konum kayması
+
+    size_t boyut() const { return x.size(); }
+    void temizle() { x.clear(); y.clear(); talep.clear(); adet.clear(); maks_sapma = 0; }
+    void ekle(double px, double py, double t, int a) {
+        x.push_back(px); y.push_back(py); talep.push_back(t); adet.push_back(a);
+    }
+};
+
+enum KumelemeYontemi { KUME_YOK, KUME_IZGARA, KUME_KMEANS };
+
+struct KumelemeAyarlari {
+    KumelemeYontemi yontem = KUME_YOK;
+    double cozunurluk = 1.0;   // Izgara hücre kenarı
+    double hata_siniri = 0;    // En büyük izin verilen konum kayması (0 = yok)
+    int k = 1000;              // k-means küme sayısı
+    int iterasyon = 10;
+    bool kesin_son = false;    // En iyi bireyi sonda tam kümeyle yeniden değerlendir
+};
+
+KumelemeAyarlari kumeAyar;
+KullaniciKumesi tamKume, kumelenmisKume;
+const KullaniciKumesi* aktifKume = &tamKume;
+
+void tamKumeOlustur(const vector<AP>& kullanicilar, KullaniciKumesi& kume) {
+    kume.temizle();
+    for (auto& k : kullanicilar) kume.ekle(k.x, k.y, k.talep, 1);
+}
+
+// Kullanıcıları h kenarlı ızgarada birleştirir; 'atama' her kullanıcının
+// düştüğü noktanın indeksini alır.
+void izgaraKumele(const vector<AP>& kullanicilar, double h, KullaniciKumesi& kume, vector<int>& atama) {
+    kume.temizle();
+    unordered_map<uint64_t, int> hucreler;
+    hucreler.reserve(kullanicilar.size() / 4 + 16);
+    vector<double> sx, sy;
+    atama.resize(kullanicilar.size());
+    for (size_t i = 0; i < kullanicilar.size(); i++) {
+        const AP& k = kullanicilar[i];
+        int64_t cx = (int64_t)floor(k.x / h), cy = (int64_t)floor(k.y / h);
+        uint64_t anahtar = ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+        auto it = hucreler.find(anahtar);
+        int idx;
+        if (it == hucreler.end()) {
+            idx = (int)kume.boyut();
+            hucreler.emplace(anahtar, idx);
+            kume.ekle(0, 0, 0, 0);
+            sx.push_back(0); sy.push_back(0);
+        } else idx = it->second;
+        sx[idx] += k.x; sy[idx] += k.y;
+        kume.talep[idx] += k.talep;
+        kume.adet[idx]++;
+        atama[i] = idx;
+    }
+    for (size_t c = 0; c < kume.boyut(); c++) {
+        kume.x[c] = sx[c] / kume.adet[c];
+        kume.y[c] = sy[c] / kume.adet[c];
+    }
+}
+
+// Ağırlıklı Lloyd: önce h = 1 ızgarasıyla kayıpsız sıkıştırır, sonra k
+// merkezi adet ağırlıklı örnekleyip bu ince noktalar üzerinde yineler.
+void kmeansKumele(const vector<AP>& kullanicilar, int k, int iterasyon, KullaniciKumesi& kume, vector<int>& atama) {
+    KullaniciKumesi ince;
+    vector<int> inceAtama;
+    izgaraKumele(kullanicilar, 1.0, ince, inceAtama);
+    int m = (int)ince.boyut();
+    k = min(k, m);
+    if (k <= 0) { kume.temizle(); atama.clear(); return; }
+
+    vector<double> mx(k), my(k);
+    {
+        vector<double> kumulatif(m);
+        double top = 0;
+        for (int i = 0; i < m; i++) kumulatif[i] = (top += ince.adet[i]);
+        for (int c = 0; c < k; c++) {
+            int i = (int)(lower_bound(kumulatif.begin(), kumulatif.end(), rand01() * top) - kumulatif.begin());
+            i = min(i, m - 1);
+            mx[c] = ince.x[i]; my[c] = ince.y[i];
+        }
+    }
+    vector<int> merkez(m, 0);
+    vector<double> sx(k), sy(k), sw(k);
+    for (int it = 0; it < iterasyon; it++) {
+        for (int i = 0; i < m; i++) {
+            double enIyi = HUGE_VAL;
+            for (int c = 0; c < k; c++) {
+                double dx = ince.x[i] - mx[c], dy = ince.y[i] - my[c];
+                double d2 = dx * dx + dy * dy;
+                if (d2 < enIyi) { enIyi = d2; merkez[i] = c; }
+            }
+        }
+        fill(sx.begin(), sx.end(), 0); fill(sy.begin(), sy.end(), 0); fill(sw.begin(), sw.end(), 0);
+        for (int i = 0; i < m; i++) {
+            int c = merkez[i];
+            sx[c] += ince.adet[i] * ince.x[i]; sy[c] += ince.adet[i] * ince.y[i]; sw[c] += ince.adet[i];
+        }
+        for (int c = 0; c < k; c++) if (sw[c] > 0) { mx[c] = sx[c] / sw[c]; my[c] = sy[c] / sw[c]; }
+    }
+
+    // Boş kümeler atlanarak nihai noktalar
+    vector<int> yeniIdx(k, -1);
+    kume.temizle();
+    for (int i = 0; i < m; i++) {
+        int c = merkez[i];
+        if (yeniIdx[c] < 0) { yeniIdx[c] = (int)kume.boyut(); kume.ekle(mx[c], my[c], 0, 0); }
+        kume.talep[yeniIdx[c]] += ince.talep[i];
+        kume.adet[yeniIdx[c]] += ince.adet[i];
+    }
+    atama.resize(kullanicilar.size());
+    for (size_t u = 0; u < kullanicilar.size(); u++) atama[u] = yeniIdx[merkez[inceAtama[u]]];
+}
+
+// Ayarlara göre aktif kümeyi kurar; kullanıcı sayısı ve sapmayı raporlar
+void kullaniciKumesiniHazirla() {
+    tamKumeOlustur(kullanicilar, tamKume);
+    aktifKume = &tamKume;
+    if (kumeAyar.yontem == KUME_YOK) return;
+
+    vector<int> atama;
+    if (kumeAyar.yontem == KUME_IZGARA) {
+        double h = kumeAyar.cozunurluk;
+        if (kumeAyar.hata_siniri > 0) h = min(h, kumeAyar.hata_siniri / sqrt(2.0));
+        izgaraKumele(kullanicilar, max(h, 1e-6), kumelenmisKume, atama);
+    } else {
+        kmeansKumele(kullanicilar, kumeAyar.k, kumeAyar.iterasyon, kumelenmisKume, atama);
+    }
+    double sapma = 0;
+    for (size_t u = 0; u < kullanicilar.size(); u++) {
+        int c = atama[u];
+        sapma = max(sapma, uzaklik(kullanicilar[u].x, kullanicilar[u].y, kumelenmisKume.x[c], kumelenmisKume.y[c]));
+    }
+    kumelenmisKume.maks_sapma = sapma;
+    aktifKume = &kumelenmisKume;
+    printf("Kumeleme: %zu kullanici -> %zu nokta, en buyuk kayma %.3f%s\n",
+           kullanicilar.size(), kumelenmisKume.boyut(), sapma,
+           kumeAyar.hata_siniri > 0 && sapma > kumeAyar.hata_siniri ? " (hata siniri asildi)" : "");
+}
+
+// ------------------------------------------------------
+// Genetik Algoritma: AP Dizisi ve Rastgele Birey Oluşturma
+// ------------------------------------------------------
+
+// Popülasyon havuzu: tüm bireyler tek bir bitişik AP dizisinde, birey başına
+// sabit 'adim' (= AP_MAX) yuva ile tutulur; bireyin gerçek AP sayısı
+// 'uzunluk' dizisindedir. Epoch'lar arası iki havuz takas edilir, böylece
+// çocuklar önceden ayrılmış tampona yerinde yazılır ve uzunluk değişse de
+// hiçbir birey yeniden bellek ayırmaz.
+struct Populasyon {
+    int boyut = 0, adim = 0;
+    vector<AP> havuz;
+    vector<int> uzunluk;
+
+    void ayir(int n, int kapasite) {
+        boyut = n;
+        adim = kapasite;
+        havuz.resize((size_t)n * kapasite);
+        uzunluk.assign(n, 0);
+    }
+    AP* birey(int i) { return &havuz[(size_t)i * adim]; }
+    const AP* birey(int i) const { return &havuz[(size_t)i * adim]; }
+    int n(int i) const { return uzunluk[i]; }
+
+    void kopyala(int hedef, const Populasyon& kaynak, int i) {
+        copy(kaynak.birey(i), kaynak.birey(i) + kaynak.n(i), birey(hedef));
+        uzunluk[hedef] = kaynak.n(i);
+    }
+};
+
+void rastgele_ap(AP& ap) {
+    ap.x = randint(0, 100);
+    ap.y = randint(0, 100);
+    ap.kanal = randint(1, 14);
+    ap.talep = rand01() * 10;
+    // 🔥 strcpy overflow potansiyeli
+    snprintf(ap.label, sizeof(ap.label), "AP_%d_%d", ap.x, ap.y);
+}
+
+void rastgele_birey(AP* birey, int n) {
+    for (int i = 0; i < n; i++) rastgele_ap(birey[i]);
+}
+
+// [AP_MIN, AP_MAX] içinde rastgele uzunlukta birey; uzunluğu döndürür
+int rastgele_birey(AP* birey) {
+    int n = randint(AP_MIN, AP_MAX + 1);
+    rastgele_birey(birey, n);
+    return n;
+}
+
+// Uzunluğu [AP_MIN, AP_MAX] aralığına çeker: fazlası kesilir, eksik rastgele AP ile tamamlanır
+void uzunluguDuzelt(AP* birey, int& n) {
+    if (n > AP_MAX) n = AP_MAX;
+    while (n < AP_MIN) rastgele_ap(birey[n++]);
+}
+
+// ------------------------------------------------------
+// Hava Süresi ve Verim Tahmini
+// ------------------------------------------------------
+// Her kullanıcı noktası uygunluktakiyle aynı kuralla (30 birim içindeki en
+// yakın AP) bağlanır. Alınan güç log-mesafe modelinden (1 birimde
+// SINYAL_P0_DBM, üs 3) gelir, SNR'dan 802.11 MCS hızı seçilir; SNR eşikleri
+// kare mesafe eşiklerine çevrildiğinden kullanıcı döngüsünde log yoktur.
+// Kullanıcının gereken hava süresi talep / hız'dır. AP'nin toplamı istasyon
+// sayısıyla düşen MAC verimine bölünür (çekişme). Aynı kanalda ve taşıyıcı
+// algılama mesafesinde (50 birim, kanalCakismasi ile aynı) olan AP'ler kanal
+// süresini paylaşır: komşulukta toplam doluluk S > 1 ise AP talebinin 1/S'i
+// taşınır. Verim (Mbps) bu taşınan talebin toplamıdır.
+// Kullanıcılar HAVA_BLOGU'luk bloklarda SoA işlenir: bağlama (AP dışta,
+// kullanıcı içte) ve hız seçimi dallanmasız döngülerdir, yalnızca AP'ye
+// toplama dağınıktır. Toplu sürüm bir kullanıcı bloğunu önbellekteyken
+// birden çok bireye uygular.
+
+const float SINYAL_P0_DBM = -30.0f;      // 1 birimde alınan güç
+const float GURULTU_DBM = -95.0f;
+const int MCS_SAYISI = 10;
+const double MCS_SNR[MCS_SAYISI] = { 5, 8, 11, 14, 17, 21, 23, 25, 29, 31 };                // dB
+const double MCS_HIZ[MCS_SAYISI] = { 6.5, 13, 19.5, 26, 39, 52, 58.5, 65, 78, 86.7 };       // Mbps, 20 MHz tek akış
+const double MAC_VERIMI = 0.75;          // Tek istasyonda başlık, ACK ve geri çekilmeden sonra kalan pay
+const double CEKISME_KATSAYISI = 0.06;   // Verim = MAC_VERIMI / (1 + k·ln N)
+const double TASIYICI_ALGILAMA2 = 2500.0;  // 50²
+const int HAVA_BLOGU = 256;
+
+// SNR ≥ MCS_SNR[m] ⇔ d² ≤ 10^((P0 - N - MCS_SNR[m]) / 15)
+struct McsEsikleri {
+    double d2[MCS_SAYISI];
+    McsEsikleri() { for (int m = 0; m < MCS_SAYISI; m++) d2[m] = pow(10.0, (SINYAL_P0_DBM - GURULTU_DBM - MCS_SNR[m]) / 15.0); }
+};
+const McsEsikleri mcsEsik;
+
+inline double mcsHizi(double d2) {
+    double h = 0.0;
+    for (int m = 0; m < MCS_SAYISI; m++) h = d2 <= mcsEsik.d2[m] ? MCS_HIZ[m] : h;
+    return h;
+}
+
+// AP başına bağlı talep (Mbps), gereken hava süresi (çekişme öncesi) ve istasyon sayısı
+struct HavaYuku {
+    double talep = 0.0, sure = 0.0, istasyon = 0.0;
+
+    void ekle(double t, int adet, double d2, double isaret = 1.0) {
+        double h = mcsHizi(d2);
+        talep += isaret * t;
+        sure += h > 0 ? isaret * t / h : 0.0;
+        istasyon += isaret * adet;
+    }
+};
+
+struct HavaSonucu {
+    double verim = 0.0;            // Taşınan talep (Mbps)
+    double karsilanan = 0.0;       // Verim / bağlı toplam talep
+    double en_yuksek_doluluk = 0.0;
+};
+
+// [bas, son) kullanıcılarının AP yüklerini 'yuk'a ekler
+void havaYukleri(const KullaniciKumesi& k, size_t bas, size_t son, const AP* birey, int n, HavaYuku* yuk) {
+    double d2[HAVA_BLOGU], hiz[HAVA_BLOGU];
+    int sec[HAVA_BLOGU];
+    for (size_t b = bas; b < son; b += HAVA_BLOGU) {
+        int m = (int)min((size_t)HAVA_BLOGU, son - b);
+        const double* __restrict kx = &k.x[b];
+        const double* __restrict ky = &k.y[b];
+        for (int i = 0; i < m; i++) { d2[i] = 900.0; sec[i] = -1; }
+        for (int j = 0; j < n; j++) {
+            double ax = birey[j].x, ay = birey[j].y;
+            for (int i = 0; i < m; i++) {
+                double dx = kx[i] - ax, dy = ky[i] - ay;
+                double e = dx * dx + dy * dy;
+                bool al = e < d2[i] || (sec[i] < 0 && e == 900.0);
+                d2[i] = al ? e : d2[i];
+                sec[i] = al ? j : sec[i];
+            }
+        }
+        for (int i = 0; i < m; i++) {
+            double h = 0.0;
+            for (int s = 0; s < MCS_SAYISI; s++) h = d2[i] <= mcsEsik.d2[s] ? MCS_HIZ[s] : h;
+            hiz[i] = h;
+        }
+        for (int i = 0; i < m; i++) {
+            if (sec[i] < 0) continue;
+            HavaYuku& y = yuk[sec[i]];
+            y.talep += k.talep[b + i];
+            y.sure += hiz[i] > 0 ? k.talep[b + i] / hiz[i] : 0.0;
+            y.istasyon += k.adet[b + i];
+        }
+    }
+}
+
+// Çekişme ve kanal paylaşımı; 'apDoluluk' verilirse AP başına komşuluk doluluğu yazılır
+HavaSonucu havaPaylasimi(const AP* birey, int n, const HavaYuku* yuk, double* apDoluluk = nullptr) {
+    HavaSonucu s;
+    thread_local vector<double> A;
+    A.resize(n);
+    double toplamTalep = 0.0;
+    for (int j = 0; j < n; j++) {
+        double N = max(1.0, yuk[j].istasyon);
+        A[j] = yuk[j].sure / (MAC_VERIMI / (1.0 + CEKISME_KATSAYISI * log(N)));
+    }
+    for (int j = 0; j < n; j++) {
+        double S = A[j];
+        for (int i = 0; i < n; i++) {
+            if (i == j || birey[i].kanal != birey[j].kanal) continue;
+            double dx = birey[i].x - birey[j].x, dy = birey[i].y - birey[j].y;
+            if (dx * dx + dy * dy < TASIYICI_ALGILAMA2) S += A[i];
+        }
+        s.verim += yuk[j].talep / max(1.0, S);
+        s.en_yuksek_doluluk = max(s.en_yuksek_doluluk, S);
+        toplamTalep += yuk[j].talep;
+        if (apDoluluk) apDoluluk[j] = S;
+    }
+    s.karsilanan = toplamTalep > 0 ? s.verim / toplamTalep : 0.0;
+    return s;
+}
+
+HavaSonucu havaSuresiTahmini(const AP* birey, int n, HavaYuku* yuk = nullptr, double* apDoluluk = nullptr) {
+    thread_local vector<HavaYuku> yerel;
+    if (!yuk) { yerel.resize(n); yuk = yerel.data(); }
+    fill(yuk, yuk + n, HavaYuku());
+    havaYukleri(*aktifKume, 0, aktifKume->boyut(), birey, n, yuk);
+    return havaPaylasimi(birey, n, yuk, apDoluluk);
+}
+
+// ------------------------------------------------------
+// Uygunluk Değerlendirmesi
+// ------------------------------------------------------
+
+// Uygunluğun bileşenleri: tek amaçlı modda sabit ağırlıklarla skora
+// indirgenir, NSGA-II modunda ayrı hedefler olarak kullanılır.
+struct Degerlendirme {
+    double kapsanan = 0.0, toplam_uzaklik = 0.0;
+    int kapsanamayan = 0, kanal_cezasi = 0;
+    int ap_sayisi = 0;
+    double verim = 0.0;   // Hava süresi tahmininden taşınan talep (Mbps), VERIM_AGIRLIGI > 0 ise
+
+    double skor() const {
+        return kapsanan - 0.1*toplam_uzaklik - 5*kapsanamayan - 2*kanal_cezasi - AP_MALIYETI*ap_sayisi
+             + VERIM_AGIRLIGI*verim;
+    }
+};
+
+// Bir kullanıcı dilimi üzerindeki kısmi toplamlar
+struct KismiToplam {
+    double kapsanan = 0.0, toplam_uzaklik = 0.0;
+    int kapsanamayan = 0;
+};
+
+// [bas, son) aralığındaki (ağırlıklı) kullanıcı noktalarını menzildeki en
+// yakın AP'ye bağlar. Karşılaştırma kare mesafeyle yapılır, karekök yalnızca
+// seçilen AP için alınır. 'yuk' boş değilse AP başına talep yükü, 'hava'
+// boş değilse aynı bağlamayla AP başına hava süresi yükü eklenir (verim
+// için ikinci bir kullanıcı geçişi gerekmez). 'atanan'/'mesafe' verilirse
+// kullanıcı i'nin AP'si ve mesafesi i. yuvaya yazılır (artımlı değerlendirme).
+void kullaniciDilimi(const KullaniciKumesi& k, size_t bas, size_t son,
+                     const AP* birey, int n, KismiToplam& t, double* yuk, HavaYuku* hava = nullptr,
+                     int* atanan = nullptr, double* mesafe = nullptr) {
+    for (size_t i = bas; i < son; i++) {
+        int secilen = -1;
+        double enYakin2 = 900.0;   // Kapsama yarıçapı 30
+        for (int j = 0; j < n; j++) {
+            double dx = k.x[i] - birey[j].x, dy = k.y[i] - birey[j].y;
+            double d2 = dx * dx + dy * dy;
+            if (d2 < enYakin2 || (secilen < 0 && d2 == enYakin2)) {
+                secilen = j;
+                enYakin2 = d2;
+            }
+        }
+        double m = secilen >= 0 ? sqrt(enYakin2) : 1e300;
+        if (atanan) { atanan[i] = secilen; mesafe[i] = m; }
+        if (secilen >= 0) {
+            if (yuk) yuk[secilen] += k.talep[i];  // taştığında hangisi?
+            if (hava) hava[secilen].ekle(k.talep[i], k.adet[i], enYakin2);
+            t.kapsanan += k.talep[i];
+            t.toplam_uzaklik += k.adet[i] * m;
+        } else t.kapsanamayan += k.adet[i];
+    }
+}
+
+// ------------------------------------------------------
+// Döşemeli Paralel Uygunluk: kullanıcı kümesi üzerinde bölme
+// ------------------------------------------------------
+// Birkaç birey ve milyonlarca kullanıcı olduğunda popülasyon üzerinden
+// paralellik yetmez; tek bir bireyin değerlendirmesi DILIM_BOYUTU noktalık
+// (≈128 KB, L2'ye sığar) dilimlere bölünür ve dilimler görev zamanlayıcıya
+// dağıtılır. Her dilim kendi kısmi toplamını ve AP yükünü
+// ayrı bir yuvaya yazar; indirgeme dilim sırasıyla yapıldığından sonuç
+// thread sayısından ve zamanlamadan bağımsız olarak bit bit aynıdır.
+
+const size_t DILIM_BOYUTU = 4096;
+
+
+struct DilimTamponu {
+    vector<KismiToplam> kismi;
+    vector<double> yuk;          // dilim * n
+    vector<HavaYuku> hava;       // dilim * n
+};
+
+void dosemeliDegerlendir(const KullaniciKumesi& k, const AP* birey, int n, KismiToplam& t, double* yuk,
+                         HavaYuku* hava = nullptr, int* atanan = nullptr, double* mesafe = nullptr) {
+    // Bekleyen thread başka bir değerlendirme görevini çalıştırabildiğinden
+    // tampon çağrıya özeldir (thread'e değil)
+    DilimTamponu tampon;
+    int dilimSayisi = (int)((k.boyut() + DILIM_BOYUTU - 1) / DILIM_BOYUTU);
+    tampon.kismi.assign(dilimSayisi, KismiToplam());
+    if (yuk) tampon.yuk.assign((size_t)dilimSayisi * n, 0.0);
+    if (hava) tampon.hava.assign((size_t)dilimSayisi * n, HavaYuku());
+    function<void(int)> isle = [&](int d) {
+        PerfFazKapsami olcum(FAZ_DEGERLENDIRME);
+        size_t bas = (size_t)d * DILIM_BOYUTU, son = min(k.boyut(), bas + DILIM_BOYUTU);
+        // Kullanıcı başına çıktılar mutlak indeksle yazılır; dilimler ayrık yuvalara düşer
+        kullaniciDilimi(k, bas, son, birey, n, tampon.kismi[d], yuk ? &tampon.yuk[(size_t)d * n] : nullptr,
+                        hava ? &tampon.hava[(size_t)d * n] : nullptr, atanan, mesafe);
+    };
+    zamanlayici.paralelIcin(dilimSayisi, isle);
+    for (int d = 0; d < dilimSayisi; d++) {
+        t.kapsanan += tampon.kismi[d].kapsanan;
+        t.toplam_uzaklik += tampon.kismi[d].toplam_uzaklik;
+        t.kapsanamayan += tampon.kismi[d].kapsanamayan;
+        if (yuk) for (int j = 0; j < n; j++) yuk[j] += tampon.yuk[(size_t)d * n + j];
+        if (hava) {
+            for (int j = 0; j < n; j++) {
+                const HavaYuku& h = tampon.hava[(size_t)d * n + j];
+                hava[j].talep += h.talep;
+                hava[j].sure += h.sure;
+                hava[j].istasyon += h.istasyon;
+            }
+        }
+    }
+}
+
+// Popülasyon için toplu tahmin: her görev UYGUNLUK_PARTISI bireyi alır ve
+// kullanıcı dilimlerini dış döngüde gezer, böylece bir dilim partideki tüm
+// bireyler için önbellekte kalır.
+void havaSuresiToplu(const AP* const* bireyler, const int* boyutlar, int adet, HavaSonucu* sonuc) {
+    const KullaniciKumesi& k = *aktifKume;
+    int adim = adet > 0 ? *max_element(boyutlar, boyutlar + adet) : 0;
+    int partiSayisi = (adet + UYGUNLUK_PARTISI - 1) / UYGUNLUK_PARTISI;
+    zamanlayici.paralelIcin(partiSayisi, [&](int p) {
+        int bas = p * UYGUNLUK_PARTISI, son = min(adet, bas + UYGUNLUK_PARTISI);
+        vector<HavaYuku> yuk((size_t)(son - bas) * adim);
+        for (size_t u = 0; u < k.boyut(); u += DILIM_BOYUTU) {
+            size_t us = min(k.boyut(), u + DILIM_BOYUTU);
+            for (int b = bas; b < son; b++) havaYukleri(k, u, us, bireyler[b], boyutlar[b], &yuk[(size_t)(b - bas) * adim]);
+        }
+        for (int b = bas; b < son; b++) sonuc[b] = havaPaylasimi(bireyler[b], boyutlar[b], &yuk[(size_t)(b - bas) * adim]);
+    });
+}
+
+// 'apYuku' verilirse n elemanlı diziye AP başına bağlı talep yazılır.
+// 'atanan'/'mesafe' (kullanıcı sayısı kadar) ve 'havaCikti' (n elemanlı,
+// verim açıksa) aynı geçişte doldurulur; ArtimliDegerlendirici bunlarla kurulur.
+Degerlendirme degerlendir(const AP* birey, int n, double* apYuku = nullptr,
+                          int* atanan = nullptr, double* mesafe = nullptr, HavaYuku* havaCikti = nullptr) {
+    IZ_BOLGE("uygunluk");
+    Degerlendirme d;
+    d.ap_sayisi = n;
+    degerlendirmeSayisi++;
+    int& kanal_cezasi = d.kanal_cezasi;
+    if (apYuku) fill(apYuku, apYuku + n, 0.0);
+
+    const KullaniciKumesi& k = *aktifKume;
+    KismiToplam t;
+    // Verim açıksa hava yükleri kapsama geçişinde birlikte toplanır. Döşemeli
+    // yolda bekleyen thread başka değerlendirme çalıştırabildiğinden tampon çağrıya özeldir.
+    vector<HavaYuku> hava;
+    HavaYuku* hv = nullptr;
+    if (VERIM_AGIRLIGI > 0) {
+        if (havaCikti) hv = havaCikti;
+        else { hava.resize(n); hv = hava.data(); }
+        fill(hv, hv + n, HavaYuku());
+    }
+    if (degerlendirmeThread > 1 && k.boyut() >= 2 * DILIM_BOYUTU) {
+        dosemeliDegerlendir(k, birey, n, t, apYuku, hv, atanan, mesafe);
+    } else {
+        kullaniciDilimi(k, 0, k.boyut(), birey, n, t, apYuku, hv, atanan, mesafe);
+    }
+    d.kapsanan = t.kapsanan;
+    d.toplam_uzaklik = t.toplam_uzaklik;
+    d.kapsanamayan = t.kapsanamayan;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i+1; j < n; j++) {
+            double d = uzaklik(birey[i].x, birey[i].y, birey[j].x, birey[j].y);
+            if (birey[i].kanal == birey[j].kanal && d < 50) kanal_cezasi++;
+        }
+    }
+    if (hv) d.verim = havaPaylasimi(birey, n, hv).verim;
+    return d;
+}
+
+double uygunluk(const AP* birey, int n) {
+    return degerlendir(birey, n).skor();
+}
+
+double uygunluk(vector<AP>& birey) {
+    return uygunluk(birey.data(), (int)birey.size());
+}
+
+// ------------------------------------------------------
+// Çaprazlama Operatörleri
+// ------------------------------------------------------
+// Hepsi na ve nb uzunluklu iki ebeveynden çocuğu önceden ayrılmış 'cocuk'
+// tamponuna (kapasite AP_MAX) yazar ve çocuk uzunluğunu nc'ye koyar.
+// Sabit uzunlukta (AP_MIN == AP_MAX) klasik operatörlere indirgenirler.
+
+enum CaprazlamaYontemi { CAPRAZ_TEK_NOKTA, CAPRAZ_UNIFORM, CAPRAZ_IKI_NOKTA, CAPRAZ_KESIT };
+
+CaprazlamaYontemi caprazYontem = CAPRAZ_TEK_NOKTA;
+
+// Her ebeveynde ayrı kesme noktası: a[0, ka) + b[kb, nb)
+void tekNoktaCaprazlama(const AP* a, int na, const AP* b, int nb, AP* cocuk, int& nc) {
+    int ka, kb;
+    if (na == nb) {
+        ka = kb = na > 1 ? randint(1, na) : 0;
+    } else {
+        ka = randint(0, na + 1);
+        kb = randint(0, nb + 1);
+    }
+    nc = min(ka, AP_MAX);
+    copy(a, a + nc, cocuk);
+    int ek = min(nb - kb, AP_MAX - nc);
+    copy(b + kb, b + kb + ek, cocuk + nc);
+    nc += ek;
+    uzunluguDuzelt(cocuk, nc);
+}
+
+// Ortak önek gen gen karıştırılır; çocuk uzunluğu ebeveynlerden birininki
+// olur ve fazlası o ebeveynden gelir.
+void uniformCaprazlama(const AP* a, int na, const AP* b, int nb, AP* cocuk, int& nc) {
+    int ortak = min(na, nb);
+    // Her 64 gen için tek bir 64 bitlik maske
+    for (int i = 0; i < ortak; i += 64) {
+        uint64_t maske = rng().sonraki();
+        for (int j = i; j < min(ortak, i + 64); j++, maske >>= 1) cocuk[j] = (maske & 1) ? a[j] : b[j];
+    }
+    const AP* uzun = na >= nb ? a : b;
+    nc = (na == nb || rand01() < 0.5) ? ortak : max(na, nb);
+    copy(uzun + ortak, uzun + nc, cocuk + ortak);
+}
+
+// Ortak önek üzerinde [p1, p2) b'den, gerisi a'dan
+void ikiNoktaCaprazlama(const AP* a, int na, const AP* b, int nb, AP* cocuk, int& nc) {
+    int ortak = min(na, nb);
+    int p1 = randint(0, ortak + 1), p2 = randint(0, ortak + 1);
+    if (p1 > p2) swap(p1, p2);
+    copy(a, a + p1, cocuk);
+    copy(b + p1, b + p2, cocuk + p1);
+    copy(a + p2, a + na, cocuk + p2);
+    nc = na;
+}
+
+// Alanı rastgele bir doğruyla ikiye böler: doğrunun bir yanındaki AP'ler
+// a'dan, diğer yanındakiler b'den gelir. Çocuk uzunluğu doğal olarak değişir;
+// hedef uzunluk sabit genomda n, değişkende iki yanın toplamıdır ve
+// [AP_MIN, AP_MAX]'a çekilir. Eksikler karşı taraftaki artıklardan
+// tamamlanır; a ve b dönüşümlü tarandığından kesme ikisine eşit dağılır.
+void kesitDuzlemiCaprazlama(const AP* a, int na, const AP* b, int nb, AP* cocuk, int& nc) {
+    double px = rand01() * ALAN_BOYUTU, py = rand01() * ALAN_BOYUTU;
+    double aci = rand01() * M_PI;
+    double nx = cos(aci), ny = sin(aci);
+    auto taraf = [&](const AP& ap) { return (ap.x - px) * nx + (ap.y - py) * ny >= 0; };
+
+    int hedef = AP_MAX;
+    if (AP_MIN == AP_MAX) {
+        hedef = AP_MAX;
+    } else {
+        int dogal = 0;
+        for (int i = 0; i < na; i++) dogal += taraf(a[i]);
+        for (int i = 0; i < nb; i++) dogal += !taraf(b[i]);
+        hedef = min(max(dogal, AP_MIN), AP_MAX);
+    }
+    int k = 0, m = max(na, nb);
+    for (int i = 0; i < m && k < hedef; i++) {
+        if (i < na && taraf(a[i])) cocuk[k++] = a[i];
+        if (k < hedef && i < nb && !taraf(b[i])) cocuk[k++] = b[i];
+    }
+    for (int i = 0; i < m && k < hedef; i++) {
+        if (i < na && !taraf(a[i])) cocuk[k++] = a[i];
+        if (k < hedef && i < nb && taraf(b[i])) cocuk[k++] = b[i];
+    }
+    nc = k;
+    uzunluguDuzelt(cocuk, nc);
+}
+
+void crossover(const AP* a, int na, const AP* b, int nb, AP* cocuk, int& nc) {
+    IZ_BOLGE("crossover");
+    switch (caprazYontem) {
+        case CAPRAZ_UNIFORM:   uniformCaprazlama(a, na, b, nb, cocuk, nc); break;
+        case CAPRAZ_IKI_NOKTA: ikiNoktaCaprazlama(a, na, b, nb, cocuk, nc); break;
+        case CAPRAZ_KESIT:     kesitDuzlemiCaprazlama(a, na, b, nb, cocuk, nc); break;
+        default:               tekNoktaCaprazlama(a, na, b, nb, cocuk, nc); break;
+    }
+}
+
+bool caprazYonteminiCoz(const char* ad, CaprazlamaYontemi& y) {
+    if (!strcmp(ad, "single")) y = CAPRAZ_TEK_NOKTA;
+    else if (!strcmp(ad, "uniform")) y = CAPRAZ_UNIFORM;
+    else if (!strcmp(ad, "two-point")) y = CAPRAZ_IKI_NOKTA;
+    else if (!strcmp(ad, "cut-plane")) y = CAPRAZ_KESIT;
+    else return false;
+    return true;
+}
+
+// ------------------------------------------------------
+// Mutasyon Operatörleri
+// ------------------------------------------------------
+
+static inline int alanaSinirla(int v) {
+    return v < 0 ? 0 : (v >= ALAN_BOYUTU ? ALAN_BOYUTU - 1 : v);
+}
+
+// 'olcek' çalıştırmanın 1/5 kuralı adım ölçeğidir
+void mutasyon(AP* birey, int& n, double olcek) {
+    IZ_BOLGE("mutasyon");
+    double sigma = mutAyar.gauss_sigma * olcek;
+    int yaricap = max(1, (int)lround(mutAyar.yerel_adim * olcek));
+    for (int i = 0; i < n; i++) {
+        AP& ap = birey[i];
+        // Kanallar çözücüye bırakıldıysa GA yalnızca konum arar
+        if (kanalCozucuModu != KC_ELITLER && rand01() < mutAyar.kanal_orani) ap.kanal = randint(1, 14);
+
+        bool tasindi = false;
+        if (mutAyar.gauss_orani > 0 && rand01() < mutAyar.gauss_orani) {
+            ap.x = alanaSinirla(ap.x + (int)lround(sigma * rastgeleNormal()));
+            ap.y = alanaSinirla(ap.y + (int)lround(sigma * rastgeleNormal()));
+            tasindi = true;
+        }
+        if (mutAyar.yerel_orani > 0 && rand01() < mutAyar.yerel_orani) {
+            ap.x = alanaSinirla(ap.x + randint(-yaricap, yaricap + 1));
+            ap.y = alanaSinirla(ap.y + randint(-yaricap, yaricap + 1));
+            tasindi = true;
+        }
+        if (tasindi) snprintf(ap.label, sizeof(ap.label), "AP_%d_%d", ap.x, ap.y);
+    }
+
+    // Uzunluk mutasyonları: rastgele konuma yeni AP ekle / rastgele bir AP'yi çıkar
+    if (n < AP_MAX && rand01() < mutAyar.ap_ekle_orani) {
+        rastgele_ap(birey[n++]);
+    }
+    if (n > AP_MIN && n > 1 && rand01() < mutAyar.ap_sil_orani) {
+        birey[randint(0, n)] = birey[n - 1];
+        n--;
+    }
+}
+
+// Epoch sonunda çağrılır: başarı oranına göre adım ölçeğini günceller,
+// uzun durgunlukta keşfi yeniden açmak için ölçeği sıfırlar.
+void adimBoyunuGuncelle(AdimAdaptasyonu& d, bool iyilesti) {
+    d.durgun = iyilesti ? 0 : d.durgun + 1;
+    if (!mutAyar.adaptif) return;
+    if (d.deneme > 0) {
+        double oran = (double)d.basari / d.deneme;
+        if (oran > 0.2) d.olcek /= 0.85;
+        else if (oran < 0.2) d.olcek *= 0.85;
+        d.olcek = min(max(d.olcek, mutAyar.olcek_min), mutAyar.olcek_max);
+    }
+    if (d.durgun >= mutAyar.durgunluk_epoch) {
+        d.olcek = 1.0;
+        d.durgun = 0;
+    }
+    d.deneme = d.basari = 0;
+}
+
+// ------------------------------------------------------
+// Ebeveyn Seçimi: elit, turnuva, sıralama ve rulet (alias yöntemi)
+// ------------------------------------------------------
+
+enum SecimYontemi { SECIM_ELIT, SECIM_TURNUVA, SECIM_SIRALAMA, SECIM_RULET };
+
+struct SecimAyarlari {
+    SecimYontemi yontem = SECIM_ELIT;
+    int elit_sayisi = 2;             // Doğrudan aktarılan en iyi birey sayısı
+    int turnuva_boyutu = 3;
+    double siralama_basinci = 1.7;   // Doğrusal sıralama baskısı, [1, 2]
+};
+
+SecimAyarlari secimAyar;
+
+// En iyi k bireyin indekslerini skor sırasıyla döndürür. Tüm popülasyonu
+// sıralamak yerine kısmi sıralama: O(P log k).
+void elitleriBul(const vector<double>& skorlar, int k, vector<int>& elitler, vector<int>& indeks) {
+    int n = (int)skorlar.size();
+    k = min(k, n);
+    indeks.resize(n);
+    for (int i = 0; i < n; i++) indeks[i] = i;
+    partial_sort(indeks.begin(), indeks.begin() + k, indeks.end(),
+                 [&](int a, int b) { return skorlar[a] > skorlar[b]; });
+    elitler.assign(indeks.begin(), indeks.begin() + k);
+}
+
+// Tüm yöntemler için ortak arayüz: hazirla() epoch başına bir kez çağrılır,
+// sec() her ebeveyn için bir popülasyon indeksi döndürür.
+// Turnuva ve elit hazırlık gerektirmez; rulet ve sıralama O(P) alias tablosu
+// kurar ve sonra O(1) örnekler. Sıralama, rütbe için bir kez O(P log P) öder.
+struct EbeveynSecici {
+    const vector<double>* skorlar = nullptr;
+    const vector<int>* elitler = nullptr;
+    vector<double> olasilik;
+    vector<int> takma;
+    vector<double> agirlik;
+    vector<int> kucuk, buyuk, sira;
+    vector<int> adaylar;
+
+    void aliasKur() {
+        int n = (int)agirlik.size();
+        double toplam = 0;
+        for (double w : agirlik) toplam += w;
+        olasilik.resize(n);
+        takma.resize(n);
+        kucuk.clear(); buyuk.clear();
+        for (int i = 0; i < n; i++) {
+            olasilik[i] = toplam > 0 ? agirlik[i] * n / toplam : 1.0;
+            (olasilik[i] < 1.0 ? kucuk : buyuk).push_back(i);
+        }
+        while (!kucuk.empty() && !buyuk.empty()) {
+            int s = kucuk.back(); kucuk.pop_back();
+            int l = buyuk.back();
+            takma[s] = l;
+            olasilik[l] -= 1.0 - olasilik[s];
+            if (olasilik[l] < 1.0) { buyuk.pop_back(); kucuk.push_back(l); }
+        }
+        for (int i : buyuk) { olasilik[i] = 1.0; takma[i] = i; }
+        for (int i : kucuk) { olasilik[i] = 1.0; takma[i] = i; }
+    }
+
+    void hazirla(const vector<double>& s, const vector<int>& e) {
+        skorlar = &s;
+        elitler = &e;
+        int n = (int)s.size();
+        if (secimAyar.yontem == SECIM_RULET) {
+            // Uygunluk negatif olabilir: en kötü bireyi sıfıra kaydır
+            double enKotu = *min_element(s.begin(), s.end());
+            agirlik.resize(n);
+            for (int i = 0; i < n; i++) agirlik[i] = s[i] - enKotu + 1e-9;
+            aliasKur();
+        } else if (secimAyar.yontem == SECIM_SIRALAMA) {
+            sira.resize(n);
+            for (int i = 0; i < n; i++) sira[i] = i;
+            sort(sira.begin(), sira.end(), [&](int a, int b) { return s[a] < s[b]; });
+            double bs = secimAyar.siralama_basinci;
+            agirlik.resize(n);
+            for (int r = 0; r < n; r++) {
+                agirlik[sira[r]] = (2.0 - bs) + 2.0 * (bs - 1.0) * r / max(1, n - 1);
+            }
+            aliasKur();
+        }
+    }
+
+    int sec() {
+        int n = (int)skorlar->size();
+        switch (secimAyar.yontem) {
+            case SECIM_TURNUVA: {
+                int t = secimAyar.turnuva_boyutu;
+                adaylar.resize(t);
+                topluRandint(adaylar.data(), t, 0, n);
+                int en = adaylar[0];
+                for (int i = 1; i < t; i++) {
+                    if ((*skorlar)[adaylar[i]] > (*skorlar)[en]) en = adaylar[i];
+                }
+                return en;
+            }
+            case SECIM_SIRALAMA:
+            case SECIM_RULET: {
+                int i = randint(0, n);
+                return rand01() < olasilik[i] ? i : takma[i];
+            }
+            default:
+                return (*elitler)[randint(0, (int)elitler->size())];
+        }
+    }
+};
+
+bool secimYonteminiCoz(const char* ad, SecimYontemi& y) {
+    if (!strcmp(ad, "elite")) y = SECIM_ELIT;
+    else if (!strcmp(ad, "tournament")) y = SECIM_TURNUVA;
+    else if (!strcmp(ad, "rank")) y = SECIM_SIRALAMA;
+    else if (!strcmp(ad, "roulette")) y = SECIM_RULET;
+    else return false;
+    return true;
+}
+
+// ------------------------------------------------------
+// Memetik Yerel Arama: elitler üzerinde tepe tırmanma / tavlama
+// ------------------------------------------------------
+// Komşu hamle tek bir AP'nin taşınması ya da kanalının değişmesidir.
+// ArtimliDegerlendirici kullanıcı başına hizmet veren AP'yi ve mesafeyi
+// tuttuğu için bir hamlenin uygunluk farkı tam değerlendirme yapmadan
+// hesaplanır: taşımada yalnızca taşınan AP'ye bağlı kullanıcılar tüm AP'lere
+// karşı yeniden taranır, diğerleri tek bir mesafeyle karşılaştırılır;
+// kanal değişikliği yalnızca o AP'nin çakışma çiftlerine bakar (O(n)).
+
+enum YerelAramaYontemi { YA_KAPALI, YA_TEPE_TIRMANMA, YA_TAVLAMA };
+
+struct YerelAramaAyarlari {
+    YerelAramaYontemi yontem = YA_KAPALI;
+    int elit_sayisi = 2;         // Her epoch iyileştirilen en iyi birey sayısı
+    int butce = 200;             // Epoch başına değerlendirme bütçesi (tüm elitler için)
+    double kanal_orani = 0.3;    // Hamlenin kanal değişikliği olma olasılığı
+    double sicaklik = 5.0;       // Tavlama başlangıç sıcaklığı
+    double sogutma = 0.97;       // Hamle başına sıcaklık çarpanı
+};
+
+YerelAramaAyarlari yaAyar;
+
+struct ArtimliDegerlendirici {
+    vector<int> atanan;          // Kullanıcıya hizmet veren AP (-1 = kapsanmıyor)
+    vector<double> mesafe;
+    Degerlendirme d;
+    // Son denenen hamlenin değiştirdiği kullanıcılar (uygulanana kadar bekler)
+    vector<int> degisen, degisenAP;
+    vector<double> degisenMesafe;
+    // VERIM_AGIRLIGI > 0 ise AP başına hava yükü ve denenen hamleninki.
+    // denenenHava yalnızca 'dokunulan' yuvalarda hava'dan ayrılır; hamle
+    // başına tam kopya yerine bu yuvalar yazılır ya da geri alınır.
+    vector<HavaYuku> hava, denenenHava;
+    vector<int> dokunulan;
+    vector<AP> gecici;
+
+    // Bağlantılar, mesafeler ve hava yükleri tek değerlendirme geçişinde kurulur
+    void kur(const AP* birey, int n) {
+        size_t u = aktifKume->boyut();
+        atanan.resize(u);
+        mesafe.resize(u);
+        hava.resize(VERIM_AGIRLIGI > 0 ? n : 0);
+        d = degerlendir(birey, n, nullptr, atanan.data(), mesafe.data(), hava.data());
+        denenenHava = hava;
+        dokunulan.clear();
+    }
+
+    // Önceki denemenin (uygulanmamış) yuvalarını geri alır
+    void denemeyiGeriAl() {
+        for (int j : dokunulan) denenenHava[j] = hava[j];
+        dokunulan.clear();
+    }
+
+    static int cakismalar(const AP* birey, int n, int j, int x, int y, int kanal) {
+        int c = 0;
+        for (int i = 0; i < n; i++) {
+            if (i != j && birey[i].kanal == kanal && uzaklik(x, y, birey[i].x, birey[i].y) < 50) c++;
+        }
+        return c;
+    }
+
+    Degerlendirme tasimaDene(const AP* birey, int n, int j, int x, int y) {
+        degerlendirmeSayisi++;
+        Degerlendirme y2 = d;
+        degisen.clear(); degisenAP.clear(); degisenMesafe.clear();
+        const KullaniciKumesi& k = *aktifKume;
+        for (size_t u = 0; u < k.boyut(); u++) {
+            double mj = uzaklik(k.x[u], k.y[u], x, y);
+            int yeniAP;
+            double yeniM;
+            if (atanan[u] == j) {
+                yeniAP = mj <= 30 ? j : -1;
+                yeniM = mj <= 30 ? mj : 1e300;
+                for (int i = 0; i < n; i++) {
+                    if (i == j) continue;
+                    double m = uzaklik(k.x[u], k.y[u], birey[i].x, birey[i].y);
+                    if (m <= 30 && m < yeniM) { yeniAP = i; yeniM = m; }
+                }
+            } else if (mj <= 30 && mj < mesafe[u]) {
+                yeniAP = j;
+                yeniM = mj;
+            } else {
+                continue;
+            }
+            if (atanan[u] >= 0) { y2.kapsanan -= k.talep[u]; y2.toplam_uzaklik -= k.adet[u] * mesafe[u]; }
+            else y2.kapsanamayan -= k.adet[u];
+            if (yeniAP >= 0) { y2.kapsanan += k.talep[u]; y2.toplam_uzaklik += k.adet[u] * yeniM; }
+            else y2.kapsanamayan += k.adet[u];
+            degisen.push_back((int)u); degisenAP.push_back(yeniAP); degisenMesafe.push_back(yeniM);
+        }
+        y2.kanal_cezasi += cakismalar(birey, n, j, x, y, birey[j].kanal)
+                         - cakismalar(birey, n, j, birey[j].x, birey[j].y, birey[j].kanal);
+        if (VERIM_AGIRLIGI > 0) {
+            // Yalnızca bağlantısı ya da mesafesi değişen kullanıcıların yükü taşınır
+            denemeyiGeriAl();
+            for (size_t i = 0; i < degisen.size(); i++) {
+                int u = degisen[i], eski = atanan[u], yeni = degisenAP[i];
+                if (eski >= 0) {
+                    denenenHava[eski].ekle(k.talep[u], k.adet[u], mesafe[u] * mesafe[u], -1.0);
+                    dokunulan.push_back(eski);
+                }
+                if (yeni >= 0) {
+                    denenenHava[yeni].ekle(k.talep[u], k.adet[u], degisenMesafe[i] * degisenMesafe[i]);
+                    dokunulan.push_back(yeni);
+                }
+            }
+            gecici.assign(birey, birey + n);
+            gecici[j].x = x; gecici[j].y = y;
+            y2.verim = havaPaylasimi(gecici.data(), n, denenenHava.data()).verim;
+        }
+        return y2;
+    }
+
+    Degerlendirme kanalDene(const AP* birey, int n, int j, int kanal) {
+        degerlendirmeSayisi++;
+        Degerlendirme y2 = d;
+        degisen.clear();
+        y2.kanal_cezasi += cakismalar(birey, n, j, birey[j].x, birey[j].y, kanal)
+                         - cakismalar(birey, n, j, birey[j].x, birey[j].y, birey[j].kanal);
+        if (VERIM_AGIRLIGI > 0) {
+            denemeyiGeriAl();   // Kanal hamlesi yükleri değiştirmez
+            gecici.assign(birey, birey + n);
+            gecici[j].kanal = kanal;
+            y2.verim = havaPaylasimi(gecici.data(), n, hava.data()).verim;
+        }
+        return y2;
+    }
+
+    // Son denenen hamleyi kabul eder
+    void uygula(const Degerlendirme& yeni) {
+        for (size_t i = 0; i < degisen.size(); i++) {
+            atanan[degisen[i]] = degisenAP[i];
+            mesafe[degisen[i]] = degisenMesafe[i];
+        }
+        for (int j : dokunulan) hava[j] = denenenHava[j];
+        dokunulan.clear();
+        d = yeni;
+    }
+};
+
+// Yerel aramanın çalıştırmadan aldığı ayarlar: yöntem/bütçe, adım ölçeği ve son tarih
+struct AramaKosullari {
+    const YerelAramaAyarlari& ya;
+    double olcek;
+    const SonTarih& sonTarih;
+};
+
+// Bir bireyi yerinde iyileştirir; en iyi bulunan skoru döndürür. Tavlamada
+// kötüleşen hamleler de kabul edilebildiğinden en iyi durum ayrıca saklanır.
+double yerelAra(AP* birey, int n, int butce, const AramaKosullari& k, ArtimliDegerlendirici& ad, vector<AP>& enIyi) {
+    const YerelAramaAyarlari& ya = k.ya;
+    ad.kur(birey, n);
+    double skor = ad.d.skor(), enIyiSkor = skor;
+    enIyi.assign(birey, birey + n);
+    double T = ya.sicaklik;
+    int yaricap = max(1, (int)lround(mutAyar.yerel_adim * k.olcek));
+
+    for (int adim = 0; adim < butce && n > 0 && !k.sonTarih.gecti(); adim++, T *= ya.sogutma) {
+        int j = randint(0, n);
+        bool kanalHamlesi = kanalCozucuModu != KC_ELITLER && rand01() < ya.kanal_orani;
+        int yx = birey[j].x, yy = birey[j].y, yk = birey[j].kanal;
+        Degerlendirme yeni;
+        if (kanalHamlesi) {
+            yk = randint(1, 14);
+            if (yk == birey[j].kanal) continue;
+            yeni = ad.kanalDene(birey, n, j, yk);
+        } else {
+            yx = alanaSinirla(yx + randint(-yaricap, yaricap + 1));
+            yy = alanaSinirla(yy + randint(-yaricap, yaricap + 1));
+            if (yx == birey[j].x && yy == birey[j].y) continue;
+            yeni = ad.tasimaDene(birey, n, j, yx, yy);
+        }
+        double fark = yeni.skor() - skor;
+        bool kabul = fark > 0 ||
+                     (ya.yontem == YA_TAVLAMA && T > 1e-12 && rand01() < exp(fark / T));
+        if (!kabul) continue;
+
+        ad.uygula(yeni);
+        skor = yeni.skor();
+        AP& ap = birey[j];
+        if (kanalHamlesi) {
+            ap.kanal = yk;
+        } else {
+            ap.x = yx; ap.y = yy;
+            snprintf(ap.label, sizeof(ap.label), "AP_%d_%d", ap.x, ap.y);
+        }
+        if (skor > enIyiSkor) {
+            enIyiSkor = skor;
+            enIyi.assign(birey, birey + n);
+        }
+    }
+    if (enIyiSkor > skor) copy(enIyi.begin(), enIyi.end(), birey);
+    // Artımlı toplamlar kayan noktada sürüklenebilir; kesin skor tam değerlendirmeden
+    return uygunluk(birey, n);
+}
+
+// Elit başına artımlı değerlendirici ve tamponlar. Çağıran (gaCalistir)
+// çalıştırma boyunca tutar: epoch'lar arasında bellek yeniden kullanılır,
+// eşzamanlı çalıştırmalar ise tampon paylaşmaz.
+struct MemetikTampon {
+    vector<ArtimliDegerlendirici> ad;
+    vector<vector<AP>> enIyi;
+    vector<uint64_t> tohum;
+};
+
+// Memetik aşama: bütçe elitlere eşit bölünür, skorlar yerinde güncellenir
+void memetikAsama(Populasyon& pop, vector<double>& skorlar, const vector<int>& elitler, const AramaKosullari& kosul,
+                  MemetikTampon& tampon) {
+    IZ_BOLGE("memetik");
+    const YerelAramaAyarlari& ya = kosul.ya;
+    if (ya.yontem == YA_KAPALI || elitler.empty()) return;
+    vector<ArtimliDegerlendirici>& ad = tampon.ad;
+    vector<vector<AP>>& enIyi = tampon.enIyi;
+    vector<uint64_t>& tohum = tampon.tohum;
+    int k = min((int)elitler.size(), ya.elit_sayisi);
+    int pay = ya.butce / max(1, k);
+    ad.resize(k);
+    enIyi.resize(k);
+    tohum.resize(k);
+    // Elitler ayrı görevlerde, her biri ana akıştan tohumlanan kendi akışıyla
+    // aranır; sonuç işçi sayısından ve zamanlamadan bağımsızdır
+    for (int i = 0; i < k; i++) tohum[i] = rng().sonraki();
+    partiliIcin(k, 1, [&](int i) {
+        PerfFazKapsami olcum(FAZ_YEREL_ARAMA);
+        if (kosul.sonTarih.gecti()) return;
+        Xoshiro256pp akis;
+        akis.tohumla(tohum[i]);
+        RastgeleAkisKapsami kapsam(akis);
+        int e = elitler[i];
+        skorlar[e] = yerelAra(pop.birey(e), pop.n(e), pay, kosul, ad[i], enIyi[i]);
+    });
+}
+
+bool yerelAramaYonteminiCoz(const char* ad, YerelAramaYontemi& y) {
+    if (!strcmp(ad, "off")) y = YA_KAPALI;
+    else if (!strcmp(ad, "hc")) y = YA_TEPE_TIRMANMA;
+    else if (!strcmp(ad, "sa")) y = YA_TAVLAMA;
+    else return false;
+    return true;
+}
+
+// ------------------------------------------------------
+// Kanal Ataması: Girişim Grafiği Boyama (DSATUR + Tabu Arama)
+// ------------------------------------------------------
+// Konumlar sabitken kanal ataması, d < 50 olan AP çiftlerinin kenar olduğu
+// girişim grafiğinin KANAL_SAYISI renkle boyanmasıdır. DSATUR açgözlü bir
+// başlangıç verir; çakışma kalırsa TabuCol yerel araması en az çakışmayı
+// arar. n AP için her şey O(n²) bellekte ve milisaniyeler içinde biter.
+
+const int KANAL_SAYISI = 13;   // Kanallar 1..13
+
+struct KanalCozucu {
+    int n = 0;
+    vector<uint8_t> komsu;       // n*n bitişiklik matrisi
+    vector<int> derece, renk;    // renk: 0..KANAL_SAYISI-1, -1 = atanmamış
+    vector<int> gamma;           // n*K: v'nin c renkli komşu sayısı
+    vector<int> tabu;            // n*K: (v, c) hamlesinin tabu bittiği iterasyon
+    vector<int> enIyiRenk;
+
+    int& g(int v, int c) { return gamma[(size_t)v * KANAL_SAYISI + c]; }
+
+    void grafKur(const AP* birey, int boyut) {
+        n = boyut;
+        komsu.assign((size_t)n * n, 0);
+        derece.assign(n, 0);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                if (uzaklik(birey[i].x, birey[i].y, birey[j].x, birey[j].y) < 50) {
+                    komsu[(size_t)i * n + j] = komsu[(size_t)j * n + i] = 1;
+                    derece[i]++; derece[j]++;
+                }
+            }
+        }
+    }
+
+    void renkVer(int v, int c) {
+        if (renk[v] >= 0) {
+            for (int u = 0; u < n; u++) if (komsu[(size_t)v * n + u]) g(u, renk[v])--;
+        }
+        renk[v] = c;
+        for (int u = 0; u < n; u++) if (komsu[(size_t)v * n + u]) g(u, c)++;
+    }
+
+    int cakismaSayisi() {
+        int c = 0;
+        for (int v = 0; v < n; v++) c += g(v, renk[v]);
+        return c / 2;
+    }
+
+    void dsatur() {
+        renk.assign(n, -1);
+        gamma.assign((size_t)n * KANAL_SAYISI, 0);
+        for (int adim = 0; adim < n; adim++) {
+            // En yüksek doygunluk (komşularda farklı renk sayısı), eşitlikte en yüksek derece
+            int sec = -1, secDoy = -1;
+            for (int v = 0; v < n; v++) {
+                if (renk[v] >= 0) continue;
+                int doy = 0;
+                for (int c = 0; c < KANAL_SAYISI; c++) doy += g(v, c) > 0;
+                if (doy > secDoy || (doy == secDoy && derece[v] > derece[sec])) { sec = v; secDoy = doy; }
+            }
+            // Komşularda en az kullanılan renk (serbest renk varsa sıfır çakışma)
+            int enC = 0;
+            for (int c = 1; c < KANAL_SAYISI; c++) if (g(sec, c) < g(sec, enC)) enC = c;
+            renkVer(sec, enC);
+        }
+    }
+
+    void tabuArama(int iterasyon) {
+        int f = cakismaSayisi(), enIyiF = f;
+        enIyiRenk = renk;
+        tabu.assign((size_t)n * KANAL_SAYISI, 0);
+        for (int it = 1; it <= iterasyon && enIyiF > 0; it++) {
+            int secV = -1, secC = -1, secFark = INT_MAX;
+            for (int v = 0; v < n; v++) {
+                int mevcut = g(v, renk[v]);
+                if (mevcut == 0) continue;
+                for (int c = 0; c < KANAL_SAYISI; c++) {
+                    if (c == renk[v]) continue;
+                    int fark = g(v, c) - mevcut;
+                    bool serbest = tabu[(size_t)v * KANAL_SAYISI + c] < it || f + fark < enIyiF;
+                    if (serbest && (fark < secFark || (fark == secFark && randint(0, 2)))) {
+                        secV = v; secC = c; secFark = fark;
+                    }
+                }
+            }
+            if (secV < 0) break;
+            tabu[(size_t)secV * KANAL_SAYISI + renk[secV]] = it + randint(0, 10) + (int)(0.6 * f);
+            renkVer(secV, secC);
+            f += secFark;
+            if (f < enIyiF) { enIyiF = f; enIyiRenk = renk; }
+        }
+        renk = enIyiRenk;
+    }
+
+    // Bireyin kanallarını yerinde yeniden atar; kalan çakışma sayısını döndürür
+    int coz(AP* birey, int boyut) {
+        grafKur(birey, boyut);
+        if (n == 0) return 0;
+        dsatur();
+        if (cakismaSayisi() > 0) {
+            tabuArama(kanalTabuIterasyon);
+            gamma.assign((size_t)n * KANAL_SAYISI, 0);
+            vector<int> son = renk;
+            renk.assign(n, -1);
+            for (int v = 0; v < n; v++) renkVer(v, son[v]);
+        }
+        for (int v = 0; v < n; v++) birey[v].kanal = renk[v] + 1;
+        return cakismaSayisi();
+    }
+};
+
+int kanalCakismasi(const AP* birey, int n) {
+    int c = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++)
+            if (birey[i].kanal == birey[j].kanal && uzaklik(birey[i].x, birey[i].y, birey[j].x, birey[j].y) < 50) c++;
+    return c;
+}
+
+// Kanalları çözer ve skoru yeniden değerlendirmeden günceller:
+// konumlar değişmediği için yalnızca çakışma terimi (ağırlık 2) ve verim
+// açıksa kanal paylaşımı değişir; AP hava yükleri aynı kalır. Çözücü
+// sınırlı iterasyonla çalıştığından sonuç gelen atamadan kötüyse eski
+// kanallar geri yüklenir, skor hiçbir zaman düşmez. Skoru kullanmayan
+// çağıran (NSGA-II çocukları) 'verimDahil' = false ile hava süresi
+// tahminini atlar; karar yalnızca çakışma sayısına göre verilir.
+double kanallariCozVeGuncelle(AP* birey, int n, double skor, bool verimDahil = true) {
+    thread_local KanalCozucu kc;
+    thread_local vector<HavaYuku> yuk;
+    thread_local vector<int> eskiKanal;
+    eskiKanal.resize(n);
+    for (int i = 0; i < n; i++) eskiKanal[i] = birey[i].kanal;
+    int once = kanalCakismasi(birey, n);
+    double verimFarki = 0.0;
+    bool verim = verimDahil && VERIM_AGIRLIGI > 0;
+    if (verim) {
+        yuk.resize(n);
+        verimFarki = -havaSuresiTahmini(birey, n, yuk.data()).verim;
+    }
+    int sonra = kc.coz(birey, n);
+    if (verim) verimFarki += havaPaylasimi(birey, n, yuk.data()).verim;
+    double fark = 2.0 * (once - sonra) + VERIM_AGIRLIGI * verimFarki;
+    if (fark < 0) {
+        for (int i = 0; i < n; i++) birey[i].kanal = eskiKanal[i];
+        return skor;
+    }
+    return skor + fark;
+}
+
+bool kanalCozucuModunuCoz(const char* ad, KanalCozucuModu& m) {
+    if (!strcmp(ad, "off")) m = KC_KAPALI;
+    else if (!strcmp(ad, "best")) m = KC_EN_IYI;
+    else if (!strcmp(ad, "elites")) m = KC_ELITLER;
+    else return false;
+    return true;
+}
+
+// ------------------------------------------------------
+// Durma Kriterleri ve Yakınsama Tespiti
+// ------------------------------------------------------
+
+struct DurmaKosullari {
+    int max_epoch = 100;
+    int durgunluk = 0;                 // Bu kadar epoch en iyi skor iyileşmezse dur (0 = kapalı)
+    double hedef_skor = HUGE_VAL;      // Bu skora ulaşılınca dur
+    double sure_sn = 0;                // Duvar saati bütçesi (0 = sınırsız)
+    uint64_t max_degerlendirme = 0;    // Değerlendirme bütçesi (0 = sınırsız)
+    double min_cesitlilik = 0;         // Farklı genom oranı bunun altına düşerse dur
+};
+
+DurmaKosullari durmaAyar;
+
+// Son çalıştırmanın özeti: kaç epoch sürdüğü ve neden durduğu
+struct CalismaOzeti {
+    int epoch = 0;
+    uint64_t degerlendirme = 0;
+    double sure_sn = 0;
+    double cesitlilik = 1.0;
+    const char* neden = "";
+};
+
+CalismaOzeti sonOzet;
+
+// Tek bir optimizasyon çalıştırmasının ayarları, durumu ve sonucu. GA motoru
+// yalnızca buraya yazar: ana çalıştırma bitince sonucunu globallere
+// yayınlar (sonucuYayinla); REST /optimize kendi bağlamında koşar ve
+// yayınlanmış sonuca, özete ya da popülasyon istatistiklerine dokunmaz.
+struct CalismaBaglami {
+    DurmaKosullari durma;
+    YerelAramaAyarlari ya;
+    SonTarih sonTarih;
+    bool yayinla = false;        // Epoch istatistiklerini popIstatistik'e yaz (panel, /stats)
+    AdimAdaptasyonu adim;
+    vector<AP> en_iyi_birey;
+    double en_iyi_skor = -1e9;
+    CalismaOzeti ozet;
+
+    AramaKosullari arama() const { return AramaKosullari{ya, adim.olcek, sonTarih}; }
+};
+
+// Ana çalıştırmanın bağlamı: ayarlar komut satırından, başlangıç en iyisi ve
+// adım durumu yayınlanmış sonuçtan (optimizasyonuSifirla sonrası boştur)
+CalismaBaglami anaBaglam() {
+    CalismaBaglami b;
+    b.durma = durmaAyar;
+    b.ya = yaAyar;
+    b.yayinla = true;
+    b.adim = adimDurumu;
+    b.en_iyi_birey = en_iyi_birey;
+    b.en_iyi_skor = en_iyi_skor;
+    return b;
+}
+
+// REST okuyucuları yayınlanmış sonucu paylaşılan kilitle kopyalar
+shared_mutex sonucKilidi;
+
+void sonucuYayinla(CalismaBaglami& b) {
+    unique_lock<shared_mutex> kilit(sonucKilidi);
+    en_iyi_birey = b.en_iyi_birey;
+    en_iyi_skor = b.en_iyi_skor;
+    sonOzet = b.ozet;
+    adimDurumu = b.adim;
+}
+
+// Genom özeti: uzunluk ve (x, y, kanal) dizisi üzerinde FNV-1a
+uint64_t genomOzeti(const AP* birey, int n) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto kat = [&](uint32_t v) { h = (h ^ v) * 0x100000001b3ULL; };
+    kat((uint32_t)n);
+    for (int i = 0; i < n; i++) {
+        kat((uint32_t)birey[i].x);
+        kat((uint32_t)birey[i].y);
+        kat((uint32_t)birey[i].kanal);
+    }
+    return h;
+}
+
+// Çeşitlilik: farklı genom özeti sayısı / popülasyon boyutu. Klonlara
+// çökmüş bir popülasyonda 1/P'ye iner. O(P·n + P log P), uygunluğa göre ihmal edilir.
+double cesitlilikOlc(const Populasyon& pop, int adet, vector<uint64_t>& ozetler) {
+    if (adet <= 0) return 0.0;
+    ozetler.resize(adet);
+    for (int i = 0; i < adet; i++) ozetler[i] = genomOzeti(pop.birey(i), pop.n(i));
+    sort(ozetler.begin(), ozetler.end());
+    int farkli = (int)(unique(ozetler.begin(), ozetler.end()) - ozetler.begin());
+    return (double)farkli / adet;
+}
+
+struct DurmaDenetimi {
+    CalismaBaglami* b = nullptr;
+    chrono::steady_clock::time_point baslangic;
+    uint64_t baslangicDegerlendirme = 0;
+    double enIyi = -HUGE_VAL;
+    int durgun = 0;
+
+    void baslat(CalismaBaglami& baglam) {
+        b = &baglam;
+        baslangic = chrono::steady_clock::now();
+        baslangicDegerlendirme = degerlendirmeSayisi;
+        enIyi = -HUGE_VAL;
+        durgun = 0;
+        b->ozet = CalismaOzeti();
+    }
+
+    double gecen() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - baslangic).count();
+    }
+
+    // Epoch sonunda çağrılır; durulacaksa nedeni, devam edilecekse nullptr döndürür
+    const char* kontrol(int tamamlananEpoch, double skor, double cesitlilik) {
+        const DurmaKosullari& k = b->durma;
+        CalismaOzeti& ozet = b->ozet;
+        if (skor > enIyi) { enIyi = skor; durgun = 0; } else durgun++;
+        ozet.epoch = tamamlananEpoch;
+        ozet.degerlendirme = degerlendirmeSayisi - baslangicDegerlendirme;
+        ozet.sure_sn = gecen();
+        ozet.cesitlilik = cesitlilik;
+
+        const char* neden = nullptr;
+        if (durdurIstegi) neden = "kullanici";
+        else if (b->sonTarih.gecti()) neden = "son tarih";
+        else if (tamamlananEpoch >= k.max_epoch) neden = "epoch";
+        else if (enIyi >= k.hedef_skor) neden = "hedef";
+        else if (k.durgunluk > 0 && durgun >= k.durgunluk) neden = "durgunluk";
+        else if (k.sure_sn > 0 && ozet.sure_sn >= k.sure_sn) neden = "sure";
+        else if (k.max_degerlendirme > 0 && ozet.degerlendirme >= k.max_degerlendirme) neden = "degerlendirme";
+        else if (k.min_cesitlilik > 0 && cesitlilik < k.min_cesitlilik) neden = "cesitlilik";
+        if (neden) ozet.neden = neden;
+        else if (duraklatildi) {
+            // Duraklatılan süre "sure" kriterine sayılmaz
+            auto bas = chrono::steady_clock::now();
+            while (duraklatildi && !durdurIstegi) usleep(20000);
+            baslangic += chrono::steady_clock::now() - bas;
+            if (durdurIstegi) ozet.neden = neden = "kullanici";
+        }
+        return neden;
+    }
+};
+
+// ------------------------------------------------------
+// Popülasyon İstatistikleri: epoch başına ortalama, varyans ve en iyi
+// ------------------------------------------------------
+// GA döngüsü skorları değerlendirme geçişinde (1/5 kuralı sayımıyla aynı
+// döngüde) Welford ile biriktirir, ek tarama yoktur. Yayın tek yazar / çok
+// okur bir seqlock'tur: okuyucu (REST, panel) kilit almadan tutarlı bir
+// anlık görüntü alır, yazar hiçbir zaman beklemez.
+
+struct PopulasyonIstatistigi {
+    int epoch = 0;
+    double ortalama = 0.0, varyans = 0.0, en_iyi = 0.0;   // Bu epoch'un skorları
+    double tum_en_iyi = 0.0;                              // Çalıştırma boyunca en iyi
+    uint64_t degerlendirme = 0;
+};
+
+struct IstatistikYayini {
+    atomic<uint64_t> surum{0};      // Tek ise yazım sürüyor
+    atomic<int> epoch{0};
+    atomic<double> ortalama{0.0}, varyans{0.0}, en_iyi{0.0}, tum_en_iyi{0.0};
+    atomic<uint64_t> degerlendirme{0};
+
+    void yayinla(const PopulasyonIstatistigi& p) {
+        surum.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        epoch.store(p.epoch, memory_order_relaxed);
+        ortalama.store(p.ortalama, memory_order_relaxed);
+        varyans.store(p.varyans, memory_order_relaxed);
+        en_iyi.store(p.en_iyi, memory_order_relaxed);
+        tum_en_iyi.store(p.tum_en_iyi, memory_order_relaxed);
+        degerlendirme.store(p.degerlendirme, memory_order_relaxed);
+        surum.fetch_add(1, memory_order_release);
+    }
+
+    PopulasyonIstatistigi oku() const {
+        PopulasyonIstatistigi p;
+        uint64_t s1, s2;
+        do {
+            s1 = surum.load(memory_order_acquire);
+            p.epoch = epoch.load(memory_order_relaxed);
+            p.ortalama = ortalama.load(memory_order_relaxed);
+            p.varyans = varyans.load(memory_order_relaxed);
+            p.en_iyi = en_iyi.load(memory_order_relaxed);
+            p.tum_en_iyi = tum_en_iyi.load(memory_order_relaxed);
+            p.degerlendirme = degerlendirme.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            s2 = surum.load(memory_order_relaxed);
+        } while (s1 != s2 || (s1 & 1));
+        return p;
+    }
+};
+
+IstatistikYayini popIstatistik;
+
+// ------------------------------------------------------
+// Tek Amaçlı Genetik Algoritma Döngüsü
+// ------------------------------------------------------
+
+// Başlangıç popülasyonu: tohumlar aynen, ardından P·TOHUM_VARYANT_ORANI
+// kadar mutasyona uğramış kopyaları, kalan yuvalar rastgele
+const double TOHUM_VARYANT_ORANI = 0.5;
+
+void populasyonuBaslat(Populasyon& pop, int P, const vector<vector<AP>>* tohumlar, double olcek) {
+    int k = 0;
+    auto tohumKopyala = [&](int hedef, const vector<AP>& t) {
+        int n = min((int)t.size(), AP_MAX);
+        copy(t.begin(), t.begin() + n, pop.birey(hedef));
+        uzunluguDuzelt(pop.birey(hedef), n);
+        pop.uzunluk[hedef] = n;
+    };
+    if (tohumlar && !tohumlar->empty()) {
+        int s = (int)tohumlar->size();
+        for (; k < min(s, P); k++) tohumKopyala(k, (*tohumlar)[k]);
+        int varyant = min(P, k + (int)(P * TOHUM_VARYANT_ORANI));
+        for (int i = 0; k < varyant; k++, i++) {
+            tohumKopyala(k, (*tohumlar)[i % s]);
+            mutasyon(pop.birey(k), pop.uzunluk[k], olcek);
+        }
+    }
+    for (; k < P; k++) pop.uzunluk[k] = rastgele_birey(pop.birey(k));
+}
+
+// P bireylik GA; ayarları 'b'den okur, en iyi sonucu ve özeti 'b'ye yazar.
+// 'tohumlar' verilirse başlangıç popülasyonunu besler; 'elitCikti' verilirse
+// son değerlendirilen popülasyonun en iyi 'elitAdet' bireyi skor sırasıyla
+// oraya yazılır (aşamalı çalıştırmalar için).
+void gaCalistir(CalismaBaglami& b, int P, const vector<vector<AP>>* tohumlar = nullptr,
+                vector<vector<AP>>* elitCikti = nullptr, int elitAdet = 0) {
+    // Havuzlar thread başına tutulur: art arda çalıştırmalarda (aşamalar, toplu
+    // senaryolar) ayrılmış bellek yeniden kullanılır. Lambdalar thread_local
+    // değişkeni yakalamaz (işçide kendi boş kopyasını görür), bu yüzden
+    // görevler çağıranın havuzuna referansla erişir.
+    thread_local Populasyon havuzA, havuzB;
+    Populasyon& populasyon = havuzA;
+    Populasyon& yeniPop = havuzB;
+    populasyon.ayir(P, AP_MAX);
+    yeniPop.ayir(P, AP_MAX);
+    populasyonuBaslat(populasyon, P, tohumlar, b.adim.olcek);
+
+    // Çocukların ebeveyn skorları: 1/5 başarı kuralı için bir sonraki epoch'ta karşılaştırılır
+    vector<double> ebeveynSkor(P, -1e18);
+    vector<double> skorlar(P);
+    vector<char> hazir(P);
+    vector<int> elitler, indeks;
+    vector<uint64_t> ozetler;
+    EbeveynSecici secici;
+    MemetikTampon memetik;
+    DurmaDenetimi denetim;
+    denetim.baslat(b);
+    int degerlendirilen = P;
+
+    for (int epoch = 0; ; epoch++) {
+        IZ_BOLGE("epoch");
+        // Bireyler UYGUNLUK_PARTISI'lık görevlerde değerlendirilir. Son tarih
+        // epoch ortasında geçerse yalnızca kesintisiz değerlendirilmiş önek kullanılır
+        fill(hazir.begin(), hazir.end(), 0);
+        partiliIcin(P, UYGUNLUK_PARTISI, [&](int i) {
+            if (i > 0 && b.sonTarih.gecti()) return;
+            skorlar[i] = uygunluk(populasyon.birey(i), populasyon.n(i));
+            hazir[i] = 1;
+        }, FAZ_DEGERLENDIRME);
+        degerlendirilen = 0;
+        while (degerlendirilen < P && hazir[degerlendirilen]) degerlendirilen++;
+        PopulasyonIstatistigi ist;
+        ist.epoch = epoch;
+        ist.en_iyi = -HUGE_VAL;
+        double m2 = 0.0;
+        for (int i = 0; i < degerlendirilen; i++) {
+            if (ebeveynSkor[i] > -1e18) {
+                b.adim.deneme++;
+                if (skorlar[i] > ebeveynSkor[i]) b.adim.basari++;
+            }
+            double fark = skorlar[i] - ist.ortalama;
+            ist.ortalama += fark / (i + 1);
+            m2 += fark * (skorlar[i] - ist.ortalama);
+            ist.en_iyi = max(ist.en_iyi, skorlar[i]);
+        }
+        ist.varyans = degerlendirilen > 1 ? m2 / (degerlendirilen - 1) : 0.0;
+        ist.tum_en_iyi = max(b.en_iyi_skor, ist.en_iyi);
+        ist.degerlendirme = degerlendirmeSayisi;
+        if (b.yayinla) popIstatistik.yayinla(ist);
+        logYaz(LOG_AYRINTI, "epoch %d: ortalama %.4f sapma %.4f en iyi %.4f",
+               epoch, ist.ortalama, sqrt(ist.varyans), ist.en_iyi);
+        if (degerlendirilen < P) {
+            int eb = (int)(max_element(skorlar.begin(), skorlar.begin() + degerlendirilen) - skorlar.begin());
+            if (skorlar[eb] > b.en_iyi_skor) {
+                b.en_iyi_skor = skorlar[eb];
+                b.en_iyi_birey.assign(populasyon.birey(eb), populasyon.birey(eb) + populasyon.n(eb));
+            }
+            denetim.kontrol(epoch, b.en_iyi_skor, b.ozet.cesitlilik);
+            break;
+        }
+        {
+            PerfFazKapsami olcum(FAZ_SECIM);
+            elitleriBul(skorlar, max(secimAyar.elit_sayisi, b.ya.elit_sayisi), elitler, indeks);
+        }
+        memetikAsama(populasyon, skorlar, elitler, b.arama(), memetik);
+        if (kanalCozucuModu == KC_ELITLER) {
+            for (int e : elitler) {
+                if (b.sonTarih.gecti()) break;
+                skorlar[e] = kanallariCozVeGuncelle(populasyon.birey(e), populasyon.n(e), skorlar[e]);
+            }
+        }
+        sort(elitler.begin(), elitler.end(), [&](int x, int y) { return skorlar[x] > skorlar[y]; });
+        if ((int)elitler.size() > secimAyar.elit_sayisi) elitler.resize(secimAyar.elit_sayisi);
+        bool iyilesti = skorlar[elitler[0]] > b.en_iyi_skor;
+        if (iyilesti) {
+            b.en_iyi_skor = skorlar[elitler[0]];
+            const AP* eb = populasyon.birey(elitler[0]);
+            b.en_iyi_birey.assign(eb, eb + populasyon.n(elitler[0]));
+        }
+        adimBoyunuGuncelle(b.adim, iyilesti);
+        if (denetim.kontrol(epoch + 1, b.en_iyi_skor, cesitlilikOlc(populasyon, P, ozetler))) break;
+        {
+            PerfFazKapsami olcum(FAZ_SECIM);
+            secici.hazirla(skorlar, elitler);
+        }
+
+        fill(ebeveynSkor.begin(), ebeveynSkor.end(), -1e18);
+        PerfFazKapsami olcum(FAZ_VARYASYON);
+        int k = 0;
+        for (int e : elitler) yeniPop.kopyala(k++, populasyon, e);
+        for (; k < P; k++) {
+            int a = secici.sec(), c = secici.sec();
+            AP* cocuk = yeniPop.birey(k);
+            int& nc = yeniPop.uzunluk[k];
+            crossover(populasyon.birey(a), populasyon.n(a), populasyon.birey(c), populasyon.n(c), cocuk, nc);
+            mutasyon(cocuk, nc, b.adim.olcek);
+            ebeveynSkor[k] = max(skorlar[a], skorlar[c]);
+        }
+        swap(populasyon, yeniPop);
+    }
+
+    if (elitCikti) {
+        // Döngü her zaman değerlendirme sonrası çıkar: skorlar 'populasyon' ile eşleşir
+        skorlar.resize(degerlendirilen);
+        elitleriBul(skorlar, elitAdet, elitler, indeks);
+        elitCikti->clear();
+        for (int e : elitler) elitCikti->emplace_back(populasyon.birey(e), populasyon.birey(e) + populasyon.n(e));
+    }
+}
+
+// ------------------------------------------------------
+// Çok Çözünürlüklü (Kabadan İnceye) Optimizasyon
+// ------------------------------------------------------
+// Her aşama aynı GA motorunu farklı bir kullanıcı kümesiyle çalıştırır:
+// ilk aşamalar kaba ızgarada (az nokta, ucuz değerlendirme) geniş
+// popülasyonla arar, sonraki aşama bir öncekinin elitleriyle tohumlanır ve
+// son aşama her zaman tam kullanıcı kümesinde biter. Kaba aşama skorları
+// yaklaşık olduğundan en iyi skor her aşamada sıfırlanır.
+
+struct CozunurlukAsamasi {
+    double h;          // Izgara hücre kenarı; 0 = tam küme
+    int populasyon;
+    int epoch;
+};
+
+vector<CozunurlukAsamasi> asamalar;
+
+// "h:populasyon:epoch,..." biçimi, ör. "8:200:30,2:100:30,0:40:40"
+bool asamalariCoz(const char* tanim, vector<CozunurlukAsamasi>& cikti) {
+    cikti.clear();
+    string s(tanim);
+    size_t bas = 0;
+    while (bas <= s.size()) {
+        size_t son = s.find(',', bas);
+        if (son == string::npos) son = s.size();
+        CozunurlukAsamasi a;
+        if (sscanf(s.substr(bas, son - bas).c_str(), "%lf:%d:%d", &a.h, &a.populasyon, &a.epoch) != 3
+            || a.populasyon < 2 || a.epoch < 1) return false;
+        cikti.push_back(a);
+        bas = son + 1;
+    }
+    if (cikti.empty()) return false;
+    if (cikti.back().h > 0) cikti.push_back({0.0, cikti.back().populasyon, cikti.back().epoch});
+    return true;
+}
+
+// 'baslangic' verilirse ilk aşamanın popülasyonunu besler (sıcak başlangıç)
+void cokCozunurlukluCalistir(CalismaBaglami& b, const vector<vector<AP>>* baslangic = nullptr) {
+    vector<vector<AP>> tohumlar, elitler;
+    if (baslangic) tohumlar = *baslangic;
+    KullaniciKumesi asamaKumesi;
+    vector<int> atama;
+    DurmaKosullari eskiDurma = b.durma;
+    const KullaniciKumesi* eskiKume = aktifKume;
+
+    for (size_t a = 0; a < asamalar.size(); a++) {
+        const CozunurlukAsamasi& as = asamalar[a];
+        if (as.h > 0) {
+            izgaraKumele(kullanicilar, as.h, asamaKumesi, atama);
+            aktifKume = &asamaKumesi;
+        } else {
+            aktifKume = &tamKume;
+        }
+        b.en_iyi_skor = -1e9;
+        b.en_iyi_birey.clear();
+        b.durma.max_epoch = as.epoch;
+
+        int sonrakiP = a + 1 < asamalar.size() ? asamalar[a + 1].populasyon : as.populasyon;
+        int elitAdet = max(1, sonrakiP / 4);
+        gaCalistir(b, as.populasyon, tohumlar.empty() ? nullptr : &tohumlar, &elitler, elitAdet);
+        swap(tohumlar, elitler);
+        printf("Asama %zu: h=%g, %zu nokta, P=%d, %d epoch, skor %.4f\n",
+               a, as.h, aktifKume->boyut(), as.populasyon, b.ozet.epoch, b.en_iyi_skor);
+    }
+    b.durma = eskiDurma;
+    aktifKume = eskiKume;
+}
+
+// ------------------------------------------------------
+// Zaman Bütçeli (Anytime) Optimizasyon
+// ------------------------------------------------------
+// İstek işleme yolunda çağrılmak üzere: çağıran bir süre bütçesi verir,
+// motor önce birkaç değerlendirmeyle birim maliyeti ölçer ve popülasyon
+// boyutunu ile yerel arama bütçesini kalan süreye yaklaşık ZAMANLI_HEDEF_EPOCH
+// epoch sığacak şekilde seçer. Kalibrasyondaki bireyler de en iyi adayıdır,
+// yani son tarih ne kadar kısa olursa olsun bir sonuç döner.
+
+const int ZAMANLI_HEDEF_EPOCH = 30;
+const int ZAMANLI_POP_MIN = 4, ZAMANLI_POP_MAX = 512;
+const double ZAMANLI_BUTCE_MAX_MS = 10000;   // REST /optimize için üst sınır
+
+struct ZamanliSonuc {
+    vector<AP> birey;
+    double skor = -1e9;
+    int epoch = 0;
+    uint64_t degerlendirme = 0;
+    int populasyon = 0;
+    double sure_ms = 0, asim_ms = 0;
+    const char* neden = "";
+};
+
+void optimizasyonuSifirla() {
+    en_iyi_skor = -1e9;
+    en_iyi_birey.clear();
+    adimDurumu = AdimAdaptasyonu();
+}
+
+// Bağlamın ayarlarıyla başlar; popülasyon ve yerel arama bütçesi yalnızca
+// bu bağlamda değiştirilir, sonuç hem bağlamda hem dönen yapıda bulunur
+ZamanliSonuc zamanliOptimizasyon(CalismaBaglami& b, double butceMs, const vector<vector<AP>>* tohumlar = nullptr) {
+    auto bas = chrono::steady_clock::now();
+    b.sonTarih.zaman = bas + chrono::microseconds((int64_t)(butceMs * 1000));
+    b.sonTarih.aktif = true;
+    b.en_iyi_skor = -1e9;
+    b.en_iyi_birey.clear();
+    b.adim = AdimAdaptasyonu();
+    uint64_t degBas = degerlendirmeSayisi;
+
+    // Kalibrasyon: en az bir, en fazla üç birey; varsa önce tohumlar
+    vector<AP> aday(AP_MAX);
+    int kalibrasyon = 0;
+    do {
+        int n;
+        if (tohumlar && kalibrasyon < (int)tohumlar->size()) {
+            const vector<AP>& t = (*tohumlar)[kalibrasyon];
+            n = min((int)t.size(), AP_MAX);
+            copy(t.begin(), t.begin() + n, aday.begin());
+        } else {
+            n = rastgele_birey(aday.data());
+        }
+        double skor = uygunluk(aday.data(), n);
+        if (skor > b.en_iyi_skor) { b.en_iyi_skor = skor; b.en_iyi_birey.assign(aday.begin(), aday.begin() + n); }
+        kalibrasyon++;
+    } while (kalibrasyon < 3 && !b.sonTarih.gecti());
+    auto kalibrasyonSonu = chrono::steady_clock::now();
+    double birimSn = chrono::duration<double>(kalibrasyonSonu - bas).count() / kalibrasyon;
+    double kalanSn = chrono::duration<double>(b.sonTarih.zaman - kalibrasyonSonu).count();
+
+    ZamanliSonuc sonuc;
+    if (kalanSn > 0) {
+        int P = (int)(kalanSn / (ZAMANLI_HEDEF_EPOCH * max(birimSn, 1e-9)));
+        P = min(max(P, ZAMANLI_POP_MIN), max(ZAMANLI_POP_MAX, POP_BOYUTU));
+        // Artımlı hamleler tam değerlendirmeden çok daha ucuz: epoch başına ~P hamle
+        if (b.ya.yontem != YA_KAPALI) b.ya.butce = P;
+        b.durma.max_epoch = INT_MAX;
+        sonuc.populasyon = P;
+        gaCalistir(b, P, tohumlar);
+    } else {
+        b.ozet = CalismaOzeti();
+        b.ozet.neden = "son tarih";
+    }
+    b.sonTarih.aktif = false;
+
+    auto bitis = chrono::steady_clock::now();
+    sonuc.birey = b.en_iyi_birey;
+    sonuc.skor = b.en_iyi_skor;
+    sonuc.epoch = b.ozet.epoch;
+    sonuc.degerlendirme = degerlendirmeSayisi - degBas;
+    sonuc.sure_ms = chrono::duration<double, milli>(bitis - bas).count();
+    sonuc.asim_ms = max(0.0, chrono::duration<double, milli>(bitis - b.sonTarih.zaman).count());
+    sonuc.neden = b.ozet.neden;
+    return sonuc;
+}
+
+// ------------------------------------------------------
+// Çok Amaçlı Optimizasyon: NSGA-II
+// ------------------------------------------------------
+// Hedefler (hepsi küçültülür): -kapsanan talep, kanal çakışması, AP sayısı.
+// Hızlı baskınlık sıralaması O(M·N²), kalabalık mesafesi O(M·N log N).
+// Tüm ara diziler NSGA2Tampon içinde bir kez ayrılır ve her nesilde
+// yeniden kullanılır; cepheler tek bir düz dizide başlangıç ofsetleriyle tutulur.
+
+const int NSGA2_HEDEF = 3;
+
+struct NSGA2Tampon {
+    int n = 0;
+    vector<double> hedef;          // n * NSGA2_HEDEF, satır düzeninde
+    vector<int> rutbe;             // Cephe numarası (0 = Pareto cephesi)
+    vector<double> kalabalik;
+    vector<int> baskinSayisi;      // Bireyi baskılayan birey sayısı
+    vector<int> baskiladiklari;    // n * n düz dizi; birey p için [p*n, p*n + baskiladikSayisi[p])
+    vector<int> baskiladikSayisi;
+    vector<int> cephe;             // Cephe sırasına göre birey indeksleri
+    vector<int> cepheBaslangic;    // k. cephe: cephe[cepheBaslangic[k] .. cepheBaslangic[k+1])
+    vector<int> gecici;
+    vector<double> yeniHedef, yeniKalabalik;   // Nesil sonu sıkıştırma tamponları
+    vector<int> yeniRutbe;
+
+    void ayir(int boyut) {
+        n = boyut;
+        hedef.resize((size_t)n * NSGA2_HEDEF);
+        rutbe.resize(n);
+        kalabalik.resize(n);
+        baskinSayisi.resize(n);
+        baskiladiklari.resize((size_t)n * n);
+        baskiladikSayisi.resize(n);
+        cephe.resize(n);
+        cepheBaslangic.reserve(n + 1);
+        gecici.reserve(n);
+        yeniHedef.resize(hedef.size());
+        yeniKalabalik.resize(n);
+        yeniRutbe.resize(n);
+    }
+    const double* h(int i) const { return &hedef[(size_t)i * NSGA2_HEDEF]; }
+};
+
+void hedefleriHesapla(const AP* birey, int n, double* h) {
+    Degerlendirme d = degerlendir(birey, n);
+    h[0] = -d.kapsanan;
+    h[1] = d.kanal_cezasi;
+    h[2] = n;
+}
+
+static inline bool baskilar(const double* a, const double* b) {
+    bool dahaIyi = false;
+    for (int m = 0; m < NSGA2_HEDEF; m++) {
+        if (a[m] > b[m]) return false;
+        if (a[m] < b[m]) dahaIyi = true;
+    }
+    return dahaIyi;
+}
+
+void baskinlikSiralamasi(NSGA2Tampon& t) {
+    int n = t.n;
+    fill(t.baskinSayisi.begin(), t.baskinSayisi.end(), 0);
+    fill(t.baskiladikSayisi.begin(), t.baskiladikSayisi.end(), 0);
+    for (int p = 0; p < n; p++) {
+        for (int q = p + 1; q < n; q++) {
+            if (baskilar(t.h(p), t.h(q))) {
+                t.baskiladiklari[(size_t)p * n + t.baskiladikSayisi[p]++] = q;
+                t.baskinSayisi[q]++;
+            } else if (baskilar(t.h(q), t.h(p))) {
+                t.baskiladiklari[(size_t)q * n + t.baskiladikSayisi[q]++] = p;
+                t.baskinSayisi[p]++;
+            }
+        }
+    }
+    int k = 0;
+    t.cepheBaslangic.clear();
+    t.cepheBaslangic.push_back(0);
+    for (int p = 0; p < n; p++) {
+        if (t.baskinSayisi[p] == 0) { t.rutbe[p] = 0; t.cephe[k++] = p; }
+    }
+    int bas = 0, rutbe = 0;
+    while (bas < k) {
+        int son = k;
+        t.cepheBaslangic.push_back(son);
+        rutbe++;
+        for (int i = bas; i < son; i++) {
+            int p = t.cephe[i];
+            for (int j = 0; j < t.baskiladikSayisi[p]; j++) {
+                int q = t.baskiladiklari[(size_t)p * n + j];
+                if (--t.baskinSayisi[q] == 0) { t.rutbe[q] = rutbe; t.cephe[k++] = q; }
+            }
+        }
+        bas = son;
+    }
+}
+
+void kalabalikMesafesi(NSGA2Tampon& t, int bas, int son) {
+    for (int i = bas; i < son; i++) t.kalabalik[t.cephe[i]] = 0.0;
+    if (son - bas <= 2) {
+        for (int i = bas; i < son; i++) t.kalabalik[t.cephe[i]] = 1e300;
+        return;
+    }
+    t.gecici.assign(t.cephe.begin() + bas, t.cephe.begin() + son);
+    for (int m = 0; m < NSGA2_HEDEF; m++) {
+        sort(t.gecici.begin(), t.gecici.end(), [&](int a, int b) { return t.h(a)[m] < t.h(b)[m]; });
+        double enAz = t.h(t.gecici.front())[m], enCok = t.h(t.gecici.back())[m];
+        t.kalabalik[t.gecici.front()] = t.kalabalik[t.gecici.back()] = 1e300;
+        if (enCok - enAz <= 0) continue;
+        for (size_t i = 1; i + 1 < t.gecici.size(); i++) {
+            t.kalabalik[t.gecici[i]] += (t.h(t.gecici[i + 1])[m] - t.h(t.gecici[i - 1])[m]) / (enCok - enAz);
+        }
+    }
+}
+
+// İkili turnuva: önce düşük rütbe, eşitse geniş kalabalık mesafesi
+int nsga2Sec(const NSGA2Tampon& t, int aralik) {
+    int a = randint(0, aralik), b = randint(0, aralik);
+    if (t.rutbe[a] != t.rutbe[b]) return t.rutbe[a] < t.rutbe[b] ? a : b;
+    return t.kalabalik[a] >= t.kalabalik[b] ? a : b;
+}
+
+void nsga2Calistir(CalismaBaglami& b, const vector<vector<AP>>* tohumlar = nullptr) {
+    int P = POP_BOYUTU;
+    // Birleşik havuz: [0, P) ebeveynler, [P, 2P) çocuklar
+    Populasyon birlesik, sonraki;
+    birlesik.ayir(2 * P, AP_MAX);
+    sonraki.ayir(2 * P, AP_MAX);
+    NSGA2Tampon t;
+    t.ayir(2 * P);
+    vector<int> secilen;
+    secilen.reserve(P);
+    vector<pair<int, int>> ebeveyn(P);   // Çocuk başına ebeveynler (1/5 kuralı için)
+
+    populasyonuBaslat(birlesik, P, tohumlar, b.adim.olcek);
+    partiliIcin(P, UYGUNLUK_PARTISI, [&](int i) {
+        hedefleriHesapla(birlesik.birey(i), birlesik.n(i), &t.hedef[(size_t)i * NSGA2_HEDEF]);
+    }, FAZ_DEGERLENDIRME);
+    // İlk nesil için rütbe/kalabalık: yalnızca ebeveynler üzerinden
+    t.n = P;
+    baskinlikSiralamasi(t);
+    for (size_t f = 0; f + 1 < t.cepheBaslangic.size(); f++) kalabalikMesafesi(t, t.cepheBaslangic[f], t.cepheBaslangic[f + 1]);
+    t.n = 2 * P;
+
+    vector<uint64_t> ozetler;
+    DurmaDenetimi denetim;
+    denetim.baslat(b);
+
+    // Durgunluk/hedef için ilk cephedeki en yüksek kapsama izlenir
+    double enIyiKapsama = -HUGE_VAL;
+    for (int nesil = 0; ; nesil++) {
+        IZ_BOLGE("nesil");
+        {
+            PerfFazKapsami olcum(FAZ_VARYASYON);
+            for (int k = P; k < 2 * P; k++) {
+                int a = nsga2Sec(t, P), c = nsga2Sec(t, P);
+                ebeveyn[k - P] = {a, c};
+                AP* cocuk = birlesik.birey(k);
+                int& nc = birlesik.uzunluk[k];
+                crossover(birlesik.birey(a), birlesik.n(a), birlesik.birey(c), birlesik.n(c), cocuk, nc);
+                mutasyon(cocuk, nc, b.adim.olcek);
+                if (kanalCozucuModu == KC_ELITLER) kanallariCozVeGuncelle(cocuk, nc, 0.0, false);
+            }
+        }
+        // Çocuklar rastgele sayı tüketmeden toplu değerlendirilir
+        partiliIcin(P, UYGUNLUK_PARTISI, [&](int i) {
+            int k = P + i;
+            hedefleriHesapla(birlesik.birey(k), birlesik.n(k), &t.hedef[(size_t)k * NSGA2_HEDEF]);
+        }, FAZ_DEGERLENDIRME);
+
+        PerfFazKapsami olcum(FAZ_SECIM);
+        baskinlikSiralamasi(t);
+        // 1/5 kuralı: ebeveynlerinden birini baskılayan ya da ilk cepheye
+        // giren çocuk başarılı sayılır (tek amaçlı skor karşılaştırmasının karşılığı)
+        for (int i = 0; i < P; i++) {
+            int k = P + i;
+            b.adim.deneme++;
+            if (t.rutbe[k] == 0 || baskilar(t.h(k), t.h(ebeveyn[i].first)) || baskilar(t.h(k), t.h(ebeveyn[i].second)))
+                b.adim.basari++;
+        }
+        secilen.clear();
+        for (size_t f = 0; f + 1 < t.cepheBaslangic.size() && (int)secilen.size() < P; f++) {
+            int bas = t.cepheBaslangic[f], son = t.cepheBaslangic[f + 1];
+            kalabalikMesafesi(t, bas, son);
+            if ((int)secilen.size() + (son - bas) <= P) {
+                secilen.insert(secilen.end(), t.cephe.begin() + bas, t.cephe.begin() + son);
+            } else {
+                // Son cephe: en geniş kalabalık mesafeli bireyler
+                int kalan = P - (int)secilen.size();
+                partial_sort(t.cephe.begin() + bas, t.cephe.begin() + bas + kalan, t.cephe.begin() + son,
+                             [&](int x, int y) { return t.kalabalik[x] > t.kalabalik[y]; });
+                secilen.insert(secilen.end(), t.cephe.begin() + bas, t.cephe.begin() + bas + kalan);
+            }
+        }
+
+        // Seçilenleri ebeveyn bölgesine taşı; hedef, rütbe ve kalabalık birlikte taşınır
+        for (int i = 0; i < P; i++) {
+            int s = secilen[i];
+            sonraki.kopyala(i, birlesik, s);
+            copy(t.h(s), t.h(s) + NSGA2_HEDEF, &t.yeniHedef[(size_t)i * NSGA2_HEDEF]);
+            t.yeniRutbe[i] = t.rutbe[s];
+            t.yeniKalabalik[i] = t.kalabalik[s];
+        }
+        copy(t.yeniHedef.begin(), t.yeniHedef.begin() + (size_t)P * NSGA2_HEDEF, t.hedef.begin());
+        copy(t.yeniRutbe.begin(), t.yeniRutbe.begin() + P, t.rutbe.begin());
+        copy(t.yeniKalabalik.begin(), t.yeniKalabalik.begin() + P, t.kalabalik.begin());
+        swap(birlesik, sonraki);
+
+        double enCokKapsama = -HUGE_VAL;
+        for (int i = 0; i < P; i++) enCokKapsama = max(enCokKapsama, -t.h(i)[0]);
+        bool iyilesti = enCokKapsama > enIyiKapsama;
+        enIyiKapsama = max(enIyiKapsama, enCokKapsama);
+        adimBoyunuGuncelle(b.adim, iyilesti);
+        if (denetim.kontrol(nesil + 1, enCokKapsama, cesitlilikOlc(birlesik, P, ozetler))) break;
+    }
+
+    // Son ebeveynlerin ilk cephesi Pareto kümesidir; aynı hedef vektörleri tekrarlanmaz
+    paretoKumesi.clear();
+    for (int i = 0; i < P; i++) {
+        if (t.rutbe[i] != 0) continue;
+        const double* h = t.h(i);
+        bool tekrar = false;
+        for (auto& pc : paretoKumesi) {
+            if (pc.kapsanan == -h[0] && pc.kanal_cezasi == (int)h[1] && pc.ap_sayisi == (int)h[2]) { tekrar = true; break; }
+        }
+        if (tekrar) continue;
+        ParetoCozum pc;
+        pc.kapsanan = -h[0];
+        pc.kanal_cezasi = (int)h[1];
+        pc.ap_sayisi = (int)h[2];
+        pc.aps.assign(birlesik.birey(i), birlesik.birey(i) + birlesik.n(i));
+        paretoKumesi.push_back(pc);
+    }
+    sort(paretoKumesi.begin(), paretoKumesi.end(),
+         [](const ParetoCozum& x, const ParetoCozum& y) { return x.kapsanan > y.kapsanan; });
+
+    // Tek amaçlı çıktılar (optimal.txt, yerlesim, /best) için kümedeki en iyi skor
+    for (auto& pc : paretoKumesi) {
+        double skor = uygunluk(pc.aps);
+        if (skor > b.en_iyi_skor) {
+            b.en_iyi_skor = skor;
+            b.en_iyi_birey = pc.aps;
+        }
+    }
+}
+
+// ------------------------------------------------------
+// Ayrık Olay Ağ Simülasyonu
+// ------------------------------------------------------
+// Yerleşimi dağıtmadan önce doğrulamak için: her kullanıcı kendi talebi
+// (Mbps) oranında Poisson paket akışı üretir, paketler bağlı AP'nin
+// kuyruğuna girer ve AP'ler 802.11 DCF (CSMA/CA) ile kanala erişir. Aynı
+// kanalda taşıyıcı algılama mesafesindeki AP'ler birbirini duyar: ortam
+// meşgulken geri sayım donar, geri sayımı aynı yuvada biten komşular
+// çarpışır, çarpışmada CW ikiye katlanır. Paket süresi MCS hızından
+// (mcsHizi) ve sabit ek yükten gelir.
+// Olaylar havuzdan ayrılan düğümlü bir eşleşme yığınında (pairing heap)
+// tutulur; silinen düğüm serbest listeye döner, bekleme olayları silinmek
+// yerine nesil numarasıyla geçersizleşir. Bağımsız tekrarlar görev
+// zamanlayıcıda paralel koşar; her tekrarın tohumu ana akıştan çekilir.
+// Sonuç AP başına teslim gecikmesi p50/p99, verim ve düşen pakettir.
+
+struct SimAyarlari {
+    double sure = 0.0;          // --simulate SANIYE; 0 = kapalı
+    int tekrar = 4;             // --sim-reps
+    double isinma = 0.1;        // Sürenin bu başlangıç payı istatistiğe girmez
+    int paket_bayt = 1500;
+    int kuyruk_siniri = 1000;   // AP kuyruğu dolunca gelen paket düşer
+};
+SimAyarlari simAyar;
+
+const int64_t SIM_YUVA_NS = 9000;     // 802.11 yuva süresi
+const int64_t SIM_DIFS_NS = 34000;
+const int64_t SIM_EK_NS = 100000;     // Önek, SIFS ve ACK
+const int SIM_CW_MIN = 16, SIM_CW_MAX = 1024, SIM_DENEME_MAX = 7;
+
+enum SimOlayTuru : uint8_t { OLAY_GELIS, OLAY_BEKLEME, OLAY_ILETIM_SONU };
+
+struct SimOlay {
+    int64_t zaman;
+    uint64_t sira;       // Eşit zamanlı olaylarda ekleme sırası; sonuç belirlenimci kalır
+    int ap;
+    uint32_t nesil;
+    SimOlayTuru tur;
+    int cocuk, kardes;   // Yığın bağları (havuz indisi, -1 = yok)
+};
+
+// Eşleşme yığını: ekleme O(1), en küçüğü alma iki geçişli birleştirme ile
+struct OlayKuyrugu {
+    vector<SimOlay> havuz;
+    vector<int> serbest, tampon;
+    int kok = -1;
+    uint64_t sira = 0;
+
+    bool once(int a, int b) const {
+        const SimOlay& x = havuz[a];
+        const SimOlay& y = havuz[b];
+        return x.zaman < y.zaman || (x.zaman == y.zaman && x.sira < y.sira);
+    }
+    int birlestir(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (once(b, a)) swap(a, b);
+        havuz[b].kardes = havuz[a].cocuk;
+        havuz[a].cocuk = b;
+        return a;
+    }
+    bool bos() const { return kok < 0; }
+
+    void ekle(int64_t zaman, SimOlayTuru tur, int ap, uint32_t nesil = 0) {
+        int i;
+        if (!serbest.empty()) { i = serbest.back(); serbest.pop_back(); }
+        else { i = (int)havuz.size(); havuz.emplace_back(); }
+        havuz[i] = SimOlay{ zaman, sira++, ap, nesil, tur, -1, -1 };
+        kok = birlestir(kok, i);
+    }
+
+    SimOlay al() {
+        int k = kok;
+        SimOlay o = havuz[k];
+        tampon.clear();
+        for (int c = o.cocuk; c >= 0;) {
+            int s = havuz[c].kardes;
+            havuz[c].kardes = -1;
+            tampon.push_back(c);
+            c = s;
+        }
+        size_t m = 0;
+        for (size_t i = 0; i + 1 < tampon.size(); i += 2) tampon[m++] = birlestir(tampon[i], tampon[i + 1]);
+        if (tampon.size() % 2) tampon[m++] = tampon.back();
+        int r = -1;
+        for (size_t i = m; i-- > 0;) r = birlestir(tampon[i], r);
+        kok = r;
+        serbest.push_back(k);
+        return o;
+    }
+};
+
+struct SimPaket {
+    int64_t gelis;
+    int64_t sure;    // Kanalda kalma süresi (ek yük dahil)
+    int deneme;
+};
+
+struct SimAP {
+    vector<int> komsu;               // Aynı kanal, taşıyıcı algılama mesafesi içinde
+    vector<int64_t> kullaniciSure;   // Bağlı kullanıcıların paket süresi
+    vector<double> kumulatif;        // Kullanıcı seçimi için birikimli talep
+    double lambda = 0.0;             // Paket/sn
+    deque<SimPaket> kuyruk;
+    int mesgul = 0;                  // Duyulan komşu iletimleri
+    bool iletimde = false, carpisma = false, bekliyor = false;
+    int cw = SIM_CW_MIN, kalanYuva = -1;
+    int64_t beklemeBas = 0, beklemeBitis = 0;
+    uint32_t nesil = 0;
+    vector<int64_t> gecikme;
+    uint64_t teslim = 0, dusen = 0, bayt = 0;
+};
+
+struct SimAPSonucu {
+    int kullanici = 0;
+    double p50_ms = 0, p99_ms = 0, verim_mbps = 0;
+    uint64_t teslim = 0, dusen = 0;
+};
+
+struct SimSonucu {
+    vector<SimAPSonucu> aps;
+    int kapsanmayan = 0;
+    uint64_t olay = 0;
+    double sure_sn = 0;
+};
+
+struct AgSimulatoru {
+    vector<SimAP> ap;
+    OlayKuyrugu q;
+    Xoshiro256pp r;
+    int64_t simdi = 0, son = 0, isinma = 0;
+    uint64_t olaySayisi = 0;
+
+    AgSimulatoru(const vector<AP>& birey, const vector<AP>& kullanici, uint64_t tohum) {
+        r.tohumla(tohum);
+        int n = (int)birey.size();
+        ap.resize(n);
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i < n; i++) {
+                if (i == j || birey[i].kanal != birey[j].kanal) continue;
+                double dx = birey[i].x - birey[j].x, dy = birey[i].y - birey[j].y;
+                if (dx * dx + dy * dy < TASIYICI_ALGILAMA2) ap[j].komsu.push_back(i);
+            }
+        double bitPaket = simAyar.paket_bayt * 8.0;
+        for (const AP& k : kullanici) {
+            int sec = enYakinAP(birey, k);
+            if (sec < 0 || k.talep <= 0) continue;
+            double dx = k.x - birey[sec].x, dy = k.y - birey[sec].y;
+            double hiz = mcsHizi(dx * dx + dy * dy);
+            if (hiz <= 0) continue;
+            SimAP& a = ap[sec];
+            a.lambda += k.talep * 1e6 / bitPaket;
+            a.kumulatif.push_back(a.lambda);
+            a.kullaniciSure.push_back(SIM_EK_NS + (int64_t)(bitPaket / (hiz * 1e6) * 1e9));
+        }
+    }
+
+    // Uygunluktaki bağlama kuralı: 30 birim içindeki en yakın AP
+    static int enYakinAP(const vector<AP>& birey, const AP& k) {
+        int sec = -1;
+        double en = 900.0;
+        for (int j = 0; j < (int)birey.size(); j++) {
+            double dx = k.x - birey[j].x, dy = k.y - birey[j].y;
+            double d2 = dx * dx + dy * dy;
+            if (d2 < en || (sec < 0 && d2 == en)) { sec = j; en = d2; }
+        }
+        return sec;
+    }
+
+    int64_t ustel(double oran) { return (int64_t)(-log(1.0 - r.birim()) / oran * 1e9) + 1; }
+
+    void erisimBaslat(int j) {
+        SimAP& a = ap[j];
+        if (a.bekliyor || a.iletimde || a.mesgul > 0 || a.kuyruk.empty()) return;
+        if (a.kalanYuva < 0) a.kalanYuva = (int)r.sinirli(a.cw);
+        a.bekliyor = true;
+        a.beklemeBas = simdi;
+        a.beklemeBitis = simdi + SIM_DIFS_NS + a.kalanYuva * SIM_YUVA_NS;
+        q.ekle(a.beklemeBitis, OLAY_BEKLEME, j, ++a.nesil);
+    }
+
+    // Komşu iletime başladı: geri sayım donar. Bitişine bir yuvadan az
+    // kalan AP ortamı algılayamaz, aynı yuvada iletir ve çarpışır.
+    void ortamMesgul(int j) {
+        SimAP& a = ap[j];
+        a.mesgul++;
+        if (!a.bekliyor || a.beklemeBitis - simdi < SIM_YUVA_NS) return;
+        int64_t gecen = simdi - a.beklemeBas - SIM_DIFS_NS;
+        if (gecen > 0) a.kalanYuva -= (int)(gecen / SIM_YUVA_NS);
+        a.bekliyor = false;
+        a.nesil++;
+    }
+
+    void ortamBos(int j) {
+        if (--ap[j].mesgul == 0) erisimBaslat(j);
+    }
+
+    void iletimBaslat(int j) {
+        SimAP& a = ap[j];
+        a.bekliyor = false;
+        a.kalanYuva = -1;
+        a.iletimde = true;
+        a.carpisma = false;
+        for (int k : a.komsu) {
+            if (ap[k].iletimde) { ap[k].carpisma = true; a.carpisma = true; }
+            ortamMesgul(k);
+        }
+        q.ekle(simdi + a.kuyruk.front().sure, OLAY_ILETIM_SONU, j);
+    }
+
+    void iletimBitti(int j) {
+        SimAP& a = ap[j];
+        a.iletimde = false;
+        SimPaket& p = a.kuyruk.front();
+        if (a.carpisma) {
+            a.cw = min(2 * a.cw, SIM_CW_MAX);
+            if (++p.deneme > SIM_DENEME_MAX) { a.kuyruk.pop_front(); a.dusen++; a.cw = SIM_CW_MIN; }
+        } else {
+            if (p.gelis >= isinma) {
+                a.gecikme.push_back(simdi - p.gelis);
+                a.teslim++;
+                a.bayt += simAyar.paket_bayt;
+            }
+            a.kuyruk.pop_front();
+            a.cw = SIM_CW_MIN;
+        }
+        for (int k : a.komsu) ortamBos(k);
+        erisimBaslat(j);
+    }
+
+    void gelis(int j) {
+        SimAP& a = ap[j];
+        double u = r.birim() * a.lambda;
+        size_t k = min(a.kumulatif.size() - 1,
+                       (size_t)(upper_bound(a.kumulatif.begin(), a.kumulatif.end(), u) - a.kumulatif.begin()));
+        if ((int)a.kuyruk.size() >= simAyar.kuyruk_siniri) a.dusen += simdi >= isinma;
+        else a.kuyruk.push_back(SimPaket{ simdi, a.kullaniciSure[k], 0 });
+        q.ekle(simdi + ustel(a.lambda), OLAY_GELIS, j);
+        erisimBaslat(j);
+    }
+
+    void calistir(double sureSn) {
+        son = (int64_t)(sureSn * 1e9);
+        isinma = (int64_t)(sureSn * simAyar.isinma * 1e9);
+        for (int j = 0; j < (int)ap.size(); j++) if (ap[j].lambda > 0) q.ekle(ustel(ap[j].lambda), OLAY_GELIS, j);
+        while (!q.bos()) {
+            SimOlay o = q.al();
+            if (o.zaman > son) break;
+            simdi = o.zaman;
+            olaySayisi++;
+            switch (o.tur) {
+                case OLAY_GELIS: gelis(o.ap); break;
+                case OLAY_BEKLEME: if (o.nesil == ap[o.ap].nesil && ap[o.ap].bekliyor) iletimBaslat(o.ap); break;
+                case OLAY_ILETIM_SONU: iletimBitti(o.ap); break;
+            }
+        }
+    }
+};
+
+double yuzdelik(vector<int64_t>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t k = min(v.size() - 1, (size_t)(p * v.size()));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k] / 1e6;
+}
+
+// Bağımsız tekrarları paralel koşar, gecikme örneklerini AP başına birleştirir
+SimSonucu agSimulasyonu(const vector<AP>& birey, double sureSn, int tekrar) {
+    IZ_BOLGE("simulasyon");
+    auto bas = chrono::steady_clock::now();
+    tekrar = max(1, tekrar);
+    vector<uint64_t> tohum(tekrar);
+    for (auto& t : tohum) t = rng().sonraki();
+    vector<unique_ptr<AgSimulatoru>> sim(tekrar);
+    zamanlayici.paralelIcin(tekrar, [&](int t) {
+        sim[t].reset(new AgSimulatoru(birey, kullanicilar, tohum[t]));
+        sim[t]->calistir(sureSn);
+    });
+
+    SimSonucu s;
+    int n = (int)birey.size();
+    s.aps.resize(n);
+    for (const AP& k : kullanicilar) {
+        int sec = AgSimulatoru::enYakinAP(birey, k);
+        if (sec < 0) s.kapsanmayan++;
+        else s.aps[sec].kullanici++;
+    }
+    double olculen = sureSn * (1.0 - simAyar.isinma) * tekrar;
+    for (int j = 0; j < n; j++) {
+        vector<int64_t> g;
+        uint64_t bayt = 0;
+        for (auto& m : sim) {
+            const SimAP& a = m->ap[j];
+            g.insert(g.end(), a.gecikme.begin(), a.gecikme.end());
+            s.aps[j].teslim += a.teslim;
+            s.aps[j].dusen += a.dusen;
+            bayt += a.bayt;
+        }
+        s.aps[j].p50_ms = yuzdelik(g, 0.50);
+        s.aps[j].p99_ms = yuzdelik(g, 0.99);
+        s.aps[j].verim_mbps = olculen > 0 ? bayt * 8.0 / 1e6 / olculen : 0.0;
+    }
+    for (auto& m : sim) s.olay += m->olaySayisi;
+    s.sure_sn = chrono::duration<double>(chrono::steady_clock::now() - bas).count();
+    return s;
+}
+
+void simulasyonRaporu(const vector<AP>& birey, const SimSonucu& s, double sureSn, int tekrar) {
+    printf("\nAg simulasyonu: %.2f sn x %d tekrar, %llu olay, %.2f sn surdu, %d kullanici kapsam disi\n",
+           sureSn, tekrar, (unsigned long long)s.olay, s.sure_sn, s.kapsanmayan);
+    printf("  AP  kanal  kullanici  verim(Mbps)  p50(ms)  p99(ms)   teslim   dusen\n");
+    for (size_t j = 0; j < s.aps.size(); j++) {
+        const SimAPSonucu& a = s.aps[j];
+        printf("  %-3zu %5d  %9d  %11.2f  %7.2f  %7.2f  %7llu  %6llu\n", j, birey[j].kanal, a.kullanici,
+               a.verim_mbps, a.p50_ms, a.p99_ms, (unsigned long long)a.teslim, (unsigned long long)a.dusen);
+        logYaz(LOG_BILGI, "Simulasyon AP %d: verim %.2f Mbps, p50 %.3f ms, p99 %.3f ms, dusen %llu",
+               (int)j, a.verim_mbps, a.p50_ms, a.p99_ms, (unsigned long long)a.dusen);
+    }
+}
+
+// ------------------------------------------------------
+// Isı Haritası Çizimi (OpenCV gerektirmez)
+// ------------------------------------------------------
+// Bir yerleşimin alan üzerindeki sinyal, kapsama ya da girişim haritası
+// istenen çözünürlükte piksel piksel hesaplanır. Yayılım modeli log-mesafe:
+// 1 birimde SINYAL_P0_DBM, üs 3 (dBm = P0 - 15·log10(d²)); kapsama eşiği
+// uygunluktaki 30 birim yarıçapa denk gelir; girişim, kanalCakismasi gibi
+// 50 birim içindeki aynı kanallı AP'lerden gelir. Satırlar görev zamanlayıcıda
+// paralel işlenir; satır içi döngüler AP başına piksel dizisi üzerinde
+// dallanmasız min/toplam olduğundan derleyici vektörleştirebilir.
+// Çıktı PPM (P6) ya da sıkıştırmasız (stored deflate) PNG'dir; zlib gerekmez.
+
+enum HaritaKipi { HARITA_SINYAL, HARITA_KAPSAMA, HARITA_GIRISIM };
+
+const float KAPSAMA_YARICAPI2 = 900.0f;   // 30²
+const float GIRISIM_MESAFESI2 = 2500.0f;  // 50², kanalCakismasi ile aynı
+
+// Bir çizim katmanı, kopyası, ham PNG satırları, deflate akışı ve yanıt
+// metnini birlikte tutar (≈ 5 × 3 bayt/piksel): boyut piksel bütçesiyle,
+// REST'te eş zamanlı çizim sayısı da ayrıca sınırlanır
+const int HARITA_KENAR_MAX = 4096;
+const long long HARITA_PIKSEL_MAX = 4LL << 20;   // ≈ 2048², istek başına ~60 MB
+const int HARITA_ES_ZAMANLI = 2;
+
+bool haritaBoyutuGecerli(int w, int h) {
+    return w >= 1 && h >= 1 && w <= HARITA_KENAR_MAX && h <= HARITA_KENAR_MAX &&
+           (long long)w * h <= HARITA_PIKSEL_MAX;
+}
+
+struct HaritaAyarlari {
+    string dosya = "kullanici_haritasi.png";   // --heatmap; .ppm uzantısı PPM yazar
+    int genislik = 512, yukseklik = 512;        // --heatmap-size WxH
+    HaritaKipi kip = HARITA_SINYAL;             // --heatmap-mode
+    bool kullanicilar = true;                   // Kullanıcı noktalarını üstüne çiz
+};
+HaritaAyarlari haritaAyar;
+
+struct Goruntu {
+    int w = 0, h = 0;
+    vector<uint8_t> rgb;   // Satır sıralı, piksel başına 3 bayt
+    uint8_t* piksel(int x, int y) { return &rgb[((size_t)y * w + x) * 3]; }
+};
+
+bool haritaKipiniCoz(const string& s, HaritaKipi& k) {
+    if (s == "signal" || s == "sinyal") k = HARITA_SINYAL;
+    else if (s == "coverage" || s == "kapsama") k = HARITA_KAPSAMA;
+    else if (s == "interference" || s == "girisim") k = HARITA_GIRISIM;
+    else return false;
+    return true;
+}
+
+// 0..255 → koyu mavi, mavi, yeşil, sarı, kırmızı doğrusal geçişli palet
+const uint8_t* paletRengi(int i) {
+    static uint8_t lut[256][3];
+    static once_flag hazir;
+    call_once(hazir, [] {
+        static const int duraklar[5][3] = { {48, 18, 59}, {40, 130, 240}, {50, 220, 100}, {250, 220, 40}, {200, 30, 20} };
+        for (int v = 0; v < 256; v++) {
+            double t = v / 255.0 * 4;
+            int a = min(3, (int)t);
+            double f = t - a;
+            for (int c = 0; c < 3; c++) lut[v][c] = (uint8_t)(duraklar[a][c] + f * (duraklar[a + 1][c] - duraklar[a][c]) + 0.5);
+        }
+    });
+    return lut[max(0, min(255, i))];
+}
+
+// Kanal başına ayırt edilebilir renk (ton çemberinde eşit aralıklı)
+void kanalRengi(int kanal, uint8_t* rgb) {
+    double h = fmod((kanal - 1) * 360.0 / 13 * 5, 360.0) / 60.0;   // Komşu kanallar uzak tonlar alır
+    double x = 1 - fabs(fmod(h, 2.0) - 1);
+    double r = 0, g = 0, b = 0;
+    switch ((int)h) {
+        case 0: r = 1; g = x; break;
+        case 1: r = x; g = 1; break;
+        case 2: g = 1; b = x; break;
+        case 3: g = x; b = 1; break;
+        case 4: r = x; b = 1; break;
+        default: r = 1; b = x; break;
+    }
+    rgb[0] = (uint8_t)(40 + 215 * r); rgb[1] = (uint8_t)(40 + 215 * g); rgb[2] = (uint8_t)(40 + 215 * b);
+}
+
+// Çizim için AP'ler SoA olarak: piksel döngüsünde yalnızca iki float dizisi okunur
+struct HaritaAPleri {
+    vector<float> x, y;
+    vector<int> kanal;
+    int n = 0;
+
+    explicit HaritaAPleri(const vector<AP>& aps) : x(aps.size()), y(aps.size()), kanal(aps.size()), n((int)aps.size()) {
+        for (int j = 0; j < n; j++) { x[j] = aps[j].x + 0.5f; y[j] = aps[j].y + 0.5f; kanal[j] = aps[j].kanal; }
+    }
+};
 
-        token = strtok(nullptr, ",");
-        if (!token) continue;
-        int y = atoi(token);
+// y satırının [x0, x1) pikselleri. Tamponlar çağrı başınadır; girişim
+// kipinde kanal başına güç toplamları da tutulur. 'sahip' verilirse piksel
+// başına en yakın AP, 'enBuyukD2' verilirse en yakın AP mesafesinin
+// (kare) en büyüğü yazılır; döşeme önbelleği bunlarla etkilenen döşemeyi bulur.
+void haritaParcasi(Goruntu& g, int y, int x0, int x1, const HaritaAPleri& a, HaritaKipi kip,
+                   int* sahip = nullptr, float* enBuyukD2 = nullptr) {
+    int w = x1 - x0;
+    float olcekX = (float)ALAN_BOYUTU / g.w, olcekY = (float)ALAN_BOYUTU / g.h;
+    float py = (y + 0.5f) * olcekY;
+    vector<float> px(w), enYakin2(w, 1e30f), sayac(w, 0.0f);
+    vector<int> secilen(w, -1);
+    vector<float> kanalGuc(kip == HARITA_GIRISIM ? (size_t)KANAL_SAYISI * w : 0, 0.0f);
+    for (int x = 0; x < w; x++) px[x] = (x0 + x + 0.5f) * olcekX;
 
-        token = strtok(nullptr, "\n");
-        if (!token) continue;
-        double t = atof(token);
+    for (int j = 0; j < a.n; j++) {
+        float dy = py - a.y[j], dy2 = dy * dy, axj = a.x[j];
+        float* __restrict d2min = enYakin2.data();
+        int* __restrict sec = secilen.data();
+        float* __restrict say = sayac.data();
+        for (int x = 0; x < w; x++) {
+            float dx = px[x] - axj;
+            float d2 = max(dx * dx + dy2, 1.0f);
+            bool yakin = d2 < d2min[x];
+            d2min[x] = yakin ? d2 : d2min[x];
+            sec[x] = yakin ? j : sec[x];
+            say[x] += d2 < KAPSAMA_YARICAPI2 ? 1.0f : 0.0f;
+        }
+        if (kip == HARITA_GIRISIM && a.kanal[j] >= 1 && a.kanal[j] <= KANAL_SAYISI) {
+            // Göreli doğrusal güç d^-3 = 1 / (d² · d); girişim mesafesinin ötesi sayılmaz
+            float* __restrict kg = &kanalGuc[(size_t)(a.kanal[j] - 1) * w];
+            for (int x = 0; x < w; x++) {
+                float dx = px[x] - axj;
+                float d2 = max(dx * dx + dy2, 1.0f);
+                kg[x] += d2 < GIRISIM_MESAFESI2 ? 1.0f / (d2 * sqrtf(d2)) : 0.0f;
+            }
+        }
+    }
 
-        AP k;
-        k.x = x; k.y = y; k.kanal = randint(1, 14); k.talep = t;
-        // 🔥 strcpy overflow riski
-        snprintf(k.label, sizeof(k.label), "%d_%d", x, y);
-        kullanicilar.push_back(k);
+    // Gürültü P0'a göre doğrusal ölçekte: 10^((N - P0) / 10)
+    const float gurultu = powf(10.0f, (GURULTU_DBM - SINYAL_P0_DBM) / 10.0f);
+    float enBuyuk = 0.0f;
+    for (int x = 0; x < w; x++) {
+        uint8_t* p = g.piksel(x0 + x, y);
+        if (sahip) sahip[x] = secilen[x];
+        if (secilen[x] < 0) { p[0] = p[1] = p[2] = 0; enBuyuk = 1e30f; continue; }   // AP yoksa her AP yakındır
+        enBuyuk = max(enBuyuk, enYakin2[x]);
+        float dbm = SINYAL_P0_DBM - 15.0f * log10f(enYakin2[x]);
+        int v;
+        if (kip == HARITA_SINYAL) {
+            v = (int)((dbm - GURULTU_DBM) / (SINYAL_P0_DBM - GURULTU_DBM) * 255);
+        } else if (kip == HARITA_KAPSAMA) {
+            // Kapsanmayan koyu, tek AP yeşil, örtüşme sarıdan kırmızıya
+            v = sayac[x] == 0 ? 0 : (int)(128 + 42 * (min(sayac[x], 4.0f) - 1));
+        } else {
+            int k = a.kanal[secilen[x]];
+            float s = 1.0f / (enYakin2[x] * sqrtf(enYakin2[x]));
+            float girisim = (k >= 1 && k <= KANAL_SAYISI && enYakin2[x] < GIRISIM_MESAFESI2)
+                          ? kanalGuc[(size_t)(k - 1) * w + x] - s : 0.0f;
+            float sinrDb = 10.0f * log10f(s / (max(girisim, 0.0f) + gurultu));
+            v = (int)((sinrDb + 10.0f) / 50.0f * 255);   // -10..40 dB
+        }
+        const uint8_t* c = paletRengi(v);
+        p[0] = c[0]; p[1] = c[1]; p[2] = c[2];
     }
-    fclose(fp);
+    if (enBuyukD2) *enBuyukD2 = max(*enBuyukD2, enBuyuk);
 }
 
-void kaydetOptimalYerlesim(const vector<AP>& optimal) {
-    FILE* fout = fopen("optimal.txt", "w");  // fopen dönüş kontrolü yok
-    if (!fout) return;
-    for (size_t i = 0; i < optimal.size(); i++) {
-        fprintf(fout, "AP #%zu: x=%d y=%d kanal=%d label=%s talep=%.2f\n", 
-                i, optimal[i].x, optimal[i].y, optimal[i].kanal, optimal[i].label, optimal[i].talep);
+// 3x5 bit rakam yazı tipi (satır başına 3 bit)
+void rakamCiz(Goruntu& g, int x0, int y0, int sayi, int olcek, const uint8_t* renk) {
+    static const uint8_t yazi[10][5] = {
+        {7,5,5,5,7}, {2,6,2,2,7}, {7,1,7,4,7}, {7,1,7,1,7}, {5,5,7,1,1},
+        {7,4,7,1,7}, {7,4,7,5,7}, {7,1,1,1,1}, {7,5,7,5,7}, {7,5,7,1,7} };
+    string s = to_string(sayi);
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] < '0' || s[i] > '9') continue;
+        const uint8_t* r = yazi[s[i] - '0'];
+        for (int yy = 0; yy < 5 * olcek; yy++)
+            for (int xx = 0; xx < 3 * olcek; xx++) {
+                int x = x0 + (int)i * 4 * olcek + xx, y = y0 + yy;
+                if (x < 0 || y < 0 || x >= g.w || y >= g.h) continue;
+                if (r[yy / olcek] & (4 >> (xx / olcek))) memcpy(g.piksel(x, y), renk, 3);
+            }
     }
+}
 
-    // 🔥 Use-After-Free zafiyeti
-    char* tehlikeliPtr = (char*)malloc(20);
-    strcpy(tehlikeliPtr, "zafiyet_test");
-    free(tehlikeliPtr);
-    fprintf(fout, "Use-after-free: %s\n", tehlikeliPtr);
+// AP'leri kanal renginde siyah çerçeveli daire olarak, kanal numarasıyla çizer
+void apIsaretle(Goruntu& g, const vector<AP>& aps) {
+    int r = max(3, g.w / 100), olcek = max(1, g.w / 256);
+    static const uint8_t siyah[3] = {0, 0, 0}, beyaz[3] = {255, 255, 255};
+    for (const AP& a : aps) {
+        int cx = (int)((a.x + 0.5) * g.w / ALAN_BOYUTU), cy = (int)((a.y + 0.5) * g.h / ALAN_BOYUTU);
+        uint8_t renk[3];
+        kanalRengi(a.kanal, renk);
+        for (int y = cy - r - 1; y <= cy + r + 1; y++)
+            for (int x = cx - r - 1; x <= cx + r + 1; x++) {
+                if (x < 0 || y < 0 || x >= g.w || y >= g.h) continue;
+                int d2 = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+                if (d2 <= r * r) memcpy(g.piksel(x, y), renk, 3);
+                else if (d2 <= (r + 1) * (r + 1)) memcpy(g.piksel(x, y), siyah, 3);
+            }
+        rakamCiz(g, cx + r + 2, cy - r - 1, a.kanal, olcek, beyaz);
+    }
+}
 
-    fclose(fout);
+// Kullanıcı noktaları ve AP işaretleri ısı katmanının üstüne çizilir
+void katmanlariCiz(Goruntu& g, const vector<AP>& aps, bool kullaniciCiz) {
+    if (kullaniciCiz) {
+        for (const AP& k : kullanicilar) {
+            int x = (int)((k.x + 0.5) * g.w / ALAN_BOYUTU), y = (int)((k.y + 0.5) * g.h / ALAN_BOYUTU);
+            if (x >= 0 && x < g.w && y >= 0 && y < g.h) { uint8_t* p = g.piksel(x, y); p[0] = p[1] = p[2] = 20; }
+        }
+    }
+    apIsaretle(g, aps);
 }
 
-// ------------------------------------------------------
-// SQLite Veritabanı İşlemleri
-// ------------------------------------------------------
+Goruntu haritaCiz(const vector<AP>& aps, int w, int h, HaritaKipi kip, bool kullaniciCiz) {
+    Goruntu g;
+    g.w = max(1, w); g.h = max(1, h);
+    g.rgb.assign((size_t)g.w * g.h * 3, 0);
+    HaritaAPleri a(aps);
+    partiliIcin(g.h, 8, [&](int y) { haritaParcasi(g, y, 0, g.w, a, kip); });
+    katmanlariCiz(g, aps, kullaniciCiz);
+    return g;
+}
 
-void veritabaniAc(const char* dbAdi) {
-    int rc = sqlite3_open(dbAdi, &db);
-    if (rc != SQLITE_OK) {
-        db = nullptr;
-    }
+string ppmKodla(const Goruntu& g) {
+    string s = "P6\n" + to_string(g.w) + " " + to_string(g.h) + "\n255\n";
+    s.append((const char*)g.rgb.data(), g.rgb.size());
+    return s;
 }
 
-void veritabaniKapat() {
-    if (db) sqlite3_close(db);
+uint32_t crc32Guncelle(uint32_t crc, const uint8_t* p, size_t n) {
+    static uint32_t tablo[256];
+    static once_flag hazir;
+    call_once(hazir, [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tablo[i] = c;
+        }
+    });
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) crc = tablo[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
 }
 
-void veritabaniyeYaz(const vector<AP>& optimal) {
-    if (!db) return;
-    const char* createSQL = 
-        "CREATE TABLE IF NOT EXISTS yerlesim ("
-        "ap_id INTEGER, x INTEGER, y INTEGER, kanal INTEGER, label TEXT, talep REAL);";
-    char* hataMesaji = nullptr;
-    sqlite3_exec(db, createSQL, nullptr, 0, &hataMesaji);
-    if (hataMesaji) sqlite3_free(hataMesaji);
+// PNG: filtresiz satırlar, en fazla 65535 baytlık stored deflate blokları
+string pngKodla(const Goruntu& g) {
+    auto be32 = [](string& s, uint32_t v) { for (int i = 3; i >= 0; i--) s += (char)((v >> (8 * i)) & 0xFF); };
+    auto parca = [&](string& cikti, const char* tur, const string& veri) {
+        be32(cikti, (uint32_t)veri.size());
+        string govde = string(tur, 4) + veri;
+        cikti += govde;
+        be32(cikti, crc32Guncelle(0, (const uint8_t*)govde.data(), govde.size()));
+    };
 
-    // 🔥 SQL Injection riski: label doğrudan query içinde
-    for (size_t i = 0; i < optimal.size(); i++) {
-        char sql[512];  // potansiyel buffer overflow
-        snprintf(sql, sizeof(sql),
-                 "INSERT INTO yerlesim (ap_id, x, y, kanal, label, talep) "
-                 "VALUES (%zu, %d, %d, %d, '%s', %.2f);",
-                 i, optimal[i].x, optimal[i].y, optimal[i].kanal, optimal[i].label, optimal[i].talep);
-        hataMesaji = nullptr;
-        sqlite3_exec(db, sql, nullptr, 0, &hataMesaji);
-        if (hataMesaji) sqlite3_free(hataMesaji);
+    size_t satir = (size_t)g.w * 3 + 1;
+    string ham;
+    ham.reserve(satir * g.h);
+    for (int y = 0; y < g.h; y++) {
+        ham += '\0';
+        ham.append((const char*)&g.rgb[(size_t)y * g.w * 3], (size_t)g.w * 3);
     }
+    string z = "\x78\x01";
+    uint32_t a = 1, b = 0;   // Adler-32
+    for (size_t i = 0; i < ham.size(); i++) { a = (a + (uint8_t)ham[i]) % 65521; b = (b + a) % 65521; }
+    for (size_t i = 0; i < ham.size() || i == 0; i += 65535) {
+        uint16_t n = (uint16_t)min<size_t>(65535, ham.size() - i);
+        z += (char)(i + n >= ham.size() ? 1 : 0);
+        z += (char)(n & 0xFF); z += (char)(n >> 8);
+        z += (char)(~n & 0xFF); z += (char)((~n >> 8) & 0xFF);
+        z.append(ham, i, n);
+    }
+    be32(z, (b << 16) | a);
+
+    string ihdr;
+    be32(ihdr, g.w); be32(ihdr, g.h);
+    ihdr += string("\x08\x02\x00\x00\x00", 5);   // 8 bit, RGB
+    string png = "\x89PNG\r\n\x1a\n";
+    parca(png, "IHDR", ihdr);
+    parca(png, "IDAT", z);
+    parca(png, "IEND", "");
+    return png;
 }
 
-// ------------------------------------------------------
-// Ağ Zamanı Simülasyonu (Integer Overflow Potansiyeli)
-// ------------------------------------------------------
+bool goruntuYaz(const Goruntu& g, const string& dosya) {
+    bool ppm = dosya.size() >= 4 && dosya.compare(dosya.size() - 4, 4, ".ppm") == 0;
+    string veri = ppm ? ppmKodla(g) : pngKodla(g);
+    FILE* f = fopen(dosya.c_str(), "wb");
+    if (!f) return false;
+    bool tamam = fwrite(veri.data(), 1, veri.size(), f) == veri.size();
+    fclose(f);
+    return tamam;
+}
 
-int agZamaniSimulasyonu(int paketBoyutu) {
-    int hesap = paketBoyutu * 1024;    // overflow riski
-    if (hesap > 100000) {
-        return 5;
-    }
-    return hesap / 100;
+// Çalışma sonunda en iyi bireyin haritası (--heatmap, --heatmap-size, --heatmap-mode)
+void gorselOlustur(const vector<AP>& ekip) {
+    IZ_BOLGE("gorselOlustur");
+    Goruntu g = haritaCiz(ekip, haritaAyar.genislik, haritaAyar.yukseklik, haritaAyar.kip, haritaAyar.kullanicilar);
+    if (goruntuYaz(g, haritaAyar.dosya)) logYaz(LOG_BILGI, "Harita yazildi: %s (%dx%d)", haritaAyar.dosya.c_str(), g.w, g.h);
+    else logYaz(LOG_UYARI, "Harita yazilamadi: %s", haritaAyar.dosya.c_str());
 }
 
 // ------------------------------------------------------
-// Genetik Algoritma: AP Dizisi ve Rastgele Birey Oluşturma
+// Artımlı Harita Önbelleği (döşemeli)
 // ------------------------------------------------------
+// Panolar aynı en iyi çözümün görüntüsünü tekrar tekrar ister; iki istek
+// arasında çoğu AP yerinden oynamaz. Isı katmanı DOSE_PIKSEL karelik
+// döşemelere bölünür ve her döşeme için o döşemede en yakın AP olan
+// AP'ler (sahipler) ile en yakın AP mesafesinin en büyüğü saklanır.
+// AP başına etki döşemeleri bundan çıkar: değişen bir AP'nin eski hali
+// döşemenin sahibiyse, yeni konumu döşemedeki bir piksele mevcut sahibinden
+// daha yakın olabiliyorsa ya da (kapsama / girişim kipinde) eski veya yeni
+// diski döşemeye değiyorsa döşeme yeniden hesaplanır; geri kalanlar aynen
+// kullanılır. Kullanıcı noktaları ve AP işaretleri her istekte kopyanın
+// üstüne çizilir.
 
-vector<AP> rastgele_birey() {
-    vector<AP> birey;
-    for (int i = 0; i < AP_SAYISI; i++) {
-        AP ap;
-        ap.x = randint(0, 100);
-        ap.y = randint(0, 100);
-        ap.kanal = randint(1, 14);
-        ap.talep = rand01(gen) * 10;
-        // 🔥 strcpy overflow potansiyeli
-        snprintf(ap.label, sizeof(ap.label), "AP_%d_%d", ap.x, ap.y);
-        birey.push_back(ap);
-    }
-    return birey;
-}
+const int DOSE_PIKSEL = 32;
 
-double uzaklik(int x1, int y1, int x2, int y2) {
-    return sqrt((x1-x2)*(x1-x2) + (y1-y2)*(y1-y2));
-}
+struct HaritaDosesi {
+    vector<int> sahipler;     // Sıralı, tekrarsız AP indisleri
+    float enBuyukD2 = 0.0f;   // Döşemedeki en yakın AP mesafesinin (kare) en büyüğü
+};
 
-double uygunluk(vector<AP>& birey) {
-    double kapsanan = 0.0, toplam_uzaklik = 0.0;
-    vector<double> kapasite_kullanim(AP_SAYISI, 0.0);
-    int kanal_cezasi = 0, kapsanamayan = 0;
+struct HaritaOnbellegi {
+    int w = 0, h = 0;
+    HaritaKipi kip = HARITA_SINYAL;
+    bool gecerli = false;
+    vector<AP> aps;            // Isı katmanının çizildiği yerleşim
+    Goruntu isi;               // Katmansız ısı görüntüsü
+    vector<HaritaDosesi> doseler;
+    int doseX = 0, doseY = 0;
+    uint64_t sonYenilenen = 0, toplamYenilenen = 0, istek = 0;
+    mutex m;
 
-    for (size_t i = 0; i < kullanicilar.size(); i++) {
-        vector<tuple<int, double>> uygun_apler;
-        for (size_t j = 0; j < birey.size(); j++) {
-            double mesafe = uzaklik(kullanicilar[i].x, kullanicilar[i].y, birey[j].x, birey[j].y);
-            if (mesafe <= 30) {
-                uygun_apler.emplace_back(j, mesafe);
-            }
+    // Döşemenin dünya koordinatlarında (piksel merkezleri) bir noktaya en yakın kare mesafesi
+    float doseMesafesi2(int d, float x, float y) const {
+        int tx = d % doseX, ty = d / doseX;
+        float ox = (float)ALAN_BOYUTU / w, oy = (float)ALAN_BOYUTU / h;
+        float x0 = (tx * DOSE_PIKSEL + 0.5f) * ox, x1 = (min(w, (tx + 1) * DOSE_PIKSEL) - 0.5f) * ox;
+        float y0 = (ty * DOSE_PIKSEL + 0.5f) * oy, y1 = (min(h, (ty + 1) * DOSE_PIKSEL) - 0.5f) * oy;
+        float dx = x < x0 ? x0 - x : (x > x1 ? x - x1 : 0.0f);
+        float dy = y < y0 ? y0 - y : (y > y1 ? y - y1 : 0.0f);
+        return dx * dx + dy * dy;
+    }
+
+    void doseCiz(int d, const HaritaAPleri& a) {
+        int tx = d % doseX, ty = d / doseX;
+        int x0 = tx * DOSE_PIKSEL, x1 = min(w, x0 + DOSE_PIKSEL);
+        int y0 = ty * DOSE_PIKSEL, y1 = min(h, y0 + DOSE_PIKSEL);
+        HaritaDosesi& t = doseler[d];
+        t.enBuyukD2 = 0.0f;
+        vector<int> sahip(x1 - x0);
+        vector<char> gorulen(a.n, 0);
+        for (int y = y0; y < y1; y++) {
+            haritaParcasi(isi, y, x0, x1, a, kip, sahip.data(), &t.enBuyukD2);
+            for (int s : sahip) if (s >= 0) gorulen[s] = 1;
         }
-        if (!uygun_apler.empty()) {
-            sort(uygun_apler.begin(), uygun_apler.end(), [](auto& a, auto& b) { return get<1>(a) < get<1>(b); });
-            int secilen = get<0>(uygun_apler[0]);
-            kapasite_kullanim[secilen] += kullanicilar[i].talep;  // taştığında hangisi?
-            kapsanan += kullanicilar[i].talep;
-            toplam_uzaklik += get<1>(uygun_apler[0]);
-        } else kapsanamayan++;
+        t.sahipler.clear();
+        for (int j = 0; j < a.n; j++) if (gorulen[j]) t.sahipler.push_back(j);
     }
 
-    for (int i = 0; i < AP_SAYISI; i++) {
-        for (int j = i+1; j < AP_SAYISI; j++) {
-            double d = uzaklik(birey[i].x, birey[i].y, birey[j].x, birey[j].y);
-            if (birey[i].kanal == birey[j].kanal && d < 50) kanal_cezasi++;
+    // Değişen AP'nin (eski ya da yeni hali) döşemeyi etkileyip etkilemediği
+    bool etkiler(int d, int j, const AP* eski, const AP* yeni) const {
+        const HaritaDosesi& t = doseler[d];
+        if (eski && binary_search(t.sahipler.begin(), t.sahipler.end(), j)) return true;
+        if (yeni && doseMesafesi2(d, yeni->x + 0.5f, yeni->y + 0.5f) <= t.enBuyukD2) return true;
+        float yaricap2 = kip == HARITA_KAPSAMA ? KAPSAMA_YARICAPI2 : (kip == HARITA_GIRISIM ? GIRISIM_MESAFESI2 : 0.0f);
+        if (yaricap2 > 0) {
+            if (eski && doseMesafesi2(d, eski->x + 0.5f, eski->y + 0.5f) < yaricap2) return true;
+            if (yeni && doseMesafesi2(d, yeni->x + 0.5f, yeni->y + 0.5f) < yaricap2) return true;
         }
+        return false;
     }
 
-    return kapsanan - 0.1*toplam_uzaklik - 5*kapsanamayan - 2*kanal_cezasi;
-}
+    // Isı katmanını 'yeni' yerleşime getirir; yeniden çizilen döşeme sayısını döndürür
+    int guncelle(const vector<AP>& yeni, int gw, int gh, HaritaKipi gkip) {
+        HaritaAPleri a(yeni);
+        if (!gecerli || gw != w || gh != h || gkip != kip) {
+            w = gw; h = gh; kip = gkip;
+            isi.w = w; isi.h = h;
+            isi.rgb.assign((size_t)w * h * 3, 0);
+            doseX = (w + DOSE_PIKSEL - 1) / DOSE_PIKSEL;
+            doseY = (h + DOSE_PIKSEL - 1) / DOSE_PIKSEL;
+            doseler.assign((size_t)doseX * doseY, HaritaDosesi());
+            partiliIcin((int)doseler.size(), 1, [&](int d) { doseCiz(d, a); });
+            aps = yeni;
+            gecerli = true;
+            return (int)doseler.size();
+        }
 
-vector<AP> crossover(const vector<AP>& a, const vector<AP>& b) {
-    int nokta = randint(1, AP_SAYISI);
-    vector<AP> yc;
-    for (int i = 0; i < nokta; i++) yc.push_back(a[i]);
-    for (int i = nokta; i < AP_SAYISI; i++) yc.push_back(b[i]);
-    return yc;
-}
+        // İndis bazlı fark: mutasyon AP sırasını korur; sayı değişirse fazlası eklenmiş/silinmiş sayılır.
+        // Sinyal kipinde kanal değişimi ısı katmanını etkilemez.
+        vector<int> degisen;
+        int ortak = min((int)aps.size(), (int)yeni.size());
+        for (int j = 0; j < max((int)aps.size(), (int)yeni.size()); j++) {
+            if (j >= ortak) { degisen.push_back(j); continue; }
+            bool konum = aps[j].x != yeni[j].x || aps[j].y != yeni[j].y;
+            bool kanal = aps[j].kanal != yeni[j].kanal;
+            if (konum || (kanal && kip == HARITA_GIRISIM)) degisen.push_back(j);
+        }
+        vector<int> kirli;
+        if (!degisen.empty()) {
+            for (int d = 0; d < (int)doseler.size(); d++) {
+                for (int j : degisen) {
+                    const AP* e = j < (int)aps.size() ? &aps[j] : nullptr;
+                    const AP* y = j < (int)yeni.size() ? &yeni[j] : nullptr;
+                    if (etkiler(d, j, e, y)) { kirli.push_back(d); break; }
+                }
+            }
+            // AP silindiyse sonraki indisler kayar; kalan sahip listeleri geçersizleşir
+            if (yeni.size() < aps.size()) {
+                kirli.clear();
+                for (int d = 0; d < (int)doseler.size(); d++) kirli.push_back(d);
+            }
+            partiliIcin((int)kirli.size(), 1, [&](int i) { doseCiz(kirli[i], a); });
+        }
+        aps = yeni;
+        return (int)kirli.size();
+    }
 
-vector<AP> mutasyon(vector<AP> birey) {
-    for (auto& ap : birey) {
-        if (rand01(gen) < 0.05) ap.kanal = randint(1, 14);
+    Goruntu ciz(const vector<AP>& yeni, int gw, int gh, HaritaKipi gkip, bool kullaniciCiz, int* yenilenen = nullptr) {
+        lock_guard<mutex> kilit(m);
+        sonYenilenen = guncelle(yeni, gw, gh, gkip);
+        toplamYenilenen += sonYenilenen;
+        istek++;
+        if (yenilenen) *yenilenen = (int)sonYenilenen;
+        Goruntu g = isi;
+        katmanlariCiz(g, yeni, kullaniciCiz);
+        return g;
     }
-    return birey;
-}
+};
+HaritaOnbellegi haritaOnbellegi;
 
 // ------------------------------------------------------
 // REST Sunucusu (cpp-httplib) ve JSON Oluşturma
 // ------------------------------------------------------
 
+// Benchmark JSON: çalıştırma özeti + faz ölçümleri (--bench-json)
+bool benchJsonYaz(const string& dosya) {
+    FILE* f = fopen(dosya.c_str(), "w");
+    if (!f) return false;
+    fprintf(f, "{ \"neden\": \"%s\", \"epoch\": %d, \"degerlendirme\": %llu, \"sure_sn\": %.6f, "
+               "\"skor\": %.6f, \"kullanici\": %zu, \"isci\": %d, \"perf\": %s }\n",
+            sonOzet.neden, sonOzet.epoch, (unsigned long long)sonOzet.degerlendirme, sonOzet.sure_sn,
+            en_iyi_skor, kullanicilar.size(), zamanlayici.boyut(), perfJson().c_str());
+    fclose(f);
+    return true;
+}
+
+// İşleyiciler yayınlanmış en iyi sonucu paylaşılan kilit altında kopyalar
+vector<AP> enIyiKopyasi(double* skor = nullptr) {
+    shared_lock<shared_mutex> kilit(sonucKilidi);
+    if (skor) *skor = en_iyi_skor;
+    return en_iyi_birey;
+}
+
+// httplib thread'leri ana akışa dokunmaz: rastgelelik kullanan her istek
+// kilit altında yalnızca bir tohum çeker ve kapsamı boyunca kendi akışını bağlar
+mutex restAkisKilidi;
+Xoshiro256pp restAkisi;
+
+Xoshiro256pp istekAkisi() {
+    lock_guard<mutex> kilit(restAkisKilidi);
+    Xoshiro256pp a;
+    a.tohumla(restAkisi.sonraki());
+    return a;
+}
+
 void baslatRESTServer() {
     httplib::Server svr;
+    restAkisi.tohumla(rng().sonraki());
+    // Sunucu ana çalıştırmadan sonra başlar; sonraki değerlendirmeler REST isteklerine aittir
+    const uint64_t anaDegerlendirme = degerlendirmeSayisi;
 
     svr.Get("/best", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /best");
+        double skor;
+        vector<AP> birey = enIyiKopyasi(&skor);
         // 🔥 JSON hatası ve potansiyel buffer overflow
-        string json = "{ \"en_iyi_skor\": " + to_string(en_iyi_skor) + ", \"aps\": [";
-        for (size_t i = 0; i < en_iyi_birey.size(); i++) {
+        string json = "{ \"en_iyi_skor\": " + to_string(skor) + ", \"aps\": [";
+        for (size_t i = 0; i < birey.size(); i++) {
             json += "{ \"id\": " + to_string(i)
-                  + ", \"x\": " + to_string(en_iyi_birey[i].x)
-                  + ", \"y\": " + to_string(en_iyi_birey[i].y)
-                  + ", \"kanal\": " + to_string(en_iyi_birey[i].kanal)
-                  + ", \"label\": \"" + en_iyi_birey[i].label + "\" },";
+                  + ", \"x\": " + to_string(birey[i].x)
+                  + ", \"y\": " + to_string(birey[i].y)
+                  + ", \"kanal\": " + to_string(birey[i].kanal)
+                  + ", \"label\": \"" + birey[i].label + "\" },";
         }
-        if (!en_iyi_birey.empty()) {
+        if (!birey.empty()) {
             json.back() = ']';
         } else {
             json += "]";
@@ -276,62 +4077,970 @@ void baslatRESTServer() {
         res.set_content(json, "application/json");
     });
 
+    svr.Get("/pareto", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /pareto");
+        // Tüm çözümlerin verimi tek toplu hava süresi tahminiyle
+        vector<const AP*> bireyler;
+        vector<int> boyutlar;
+        for (const ParetoCozum& pc : paretoKumesi) { bireyler.push_back(pc.aps.data()); boyutlar.push_back((int)pc.aps.size()); }
+        vector<HavaSonucu> hava(paretoKumesi.size());
+        havaSuresiToplu(bireyler.data(), boyutlar.data(), (int)bireyler.size(), hava.data());
+        string json = "{ \"cozumler\": [";
+        for (size_t c = 0; c < paretoKumesi.size(); c++) {
+            const ParetoCozum& pc = paretoKumesi[c];
+            json += string(c ? "," : "") + "{ \"id\": " + to_string(c)
+                  + ", \"kapsanan\": " + to_string(pc.kapsanan)
+                  + ", \"verim_mbps\": " + to_string(hava[c].verim)
+                  + ", \"kanal_cezasi\": " + to_string(pc.kanal_cezasi)
+                  + ", \"ap_sayisi\": " + to_string(pc.ap_sayisi) + ", \"aps\": [";
+            for (size_t i = 0; i < pc.aps.size(); i++) {
+                json += string(i ? "," : "") + "{ \"x\": " + to_string(pc.aps[i].x)
+                      + ", \"y\": " + to_string(pc.aps[i].y)
+                      + ", \"kanal\": " + to_string(pc.aps[i].kanal) + " }";
+            }
+            json += "] }";
+        }
+        json += "] }";
+        res.set_content(json, "application/json");
+    });
+
+    // En iyi bireyin hava süresi tahmini: AP başına yük, doluluk ve taşınan verim
+    svr.Get("/airtime", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /airtime");
+        vector<AP> birey = enIyiKopyasi();
+        int n = (int)birey.size();
+        vector<HavaYuku> yuk(n);
+        vector<double> doluluk(n);
+        HavaSonucu h = havaSuresiTahmini(birey.data(), n, yuk.data(), doluluk.data());
+        string json = "{ \"verim_mbps\": " + to_string(h.verim)
+                    + ", \"karsilanan\": " + to_string(h.karsilanan)
+                    + ", \"en_yuksek_doluluk\": " + to_string(h.en_yuksek_doluluk) + ", \"aps\": [";
+        for (int j = 0; j < n; j++) {
+            json += string(j ? "," : "") + "{ \"id\": " + to_string(j)
+                  + ", \"kanal\": " + to_string(birey[j].kanal)
+                  + ", \"talep_mbps\": " + to_string(yuk[j].talep)
+                  + ", \"istasyon\": " + to_string((long long)yuk[j].istasyon)
+                  + ", \"hava_suresi\": " + to_string(yuk[j].sure)
+                  + ", \"doluluk\": " + to_string(doluluk[j]) + " }";
+        }
+        json += "] }";
+        res.set_content(json, "application/json");
+    });
+
+    // En iyi bireyde ağ simülasyonu: /simulate?sure=0.5&tekrar=4
+    svr.Get("/simulate", [&](const httplib::Request& req, httplib::Response& res) {
+        IZ_BOLGE("REST /simulate");
+        double sure = req.has_param("sure") ? atof(req.get_param_value("sure").c_str()) : 0.5;
+        int tekrar = req.has_param("tekrar") ? atoi(req.get_param_value("tekrar").c_str()) : simAyar.tekrar;
+        if (sure <= 0 || sure > 60 || tekrar < 1 || tekrar > 64) {
+            res.status = 400;
+            res.set_content("{ \"hata\": \"sure 0..60 sn, tekrar 1..64 olmali\" }", "application/json");
+            return;
+        }
+        vector<AP> birey = enIyiKopyasi();
+        RastgeleAkisKapsami kapsam(istekAkisi());
+        SimSonucu s = agSimulasyonu(birey, sure, tekrar);
+        string json = "{ \"sure_sn\": " + to_string(sure) + ", \"tekrar\": " + to_string(tekrar)
+                    + ", \"olay\": " + to_string(s.olay) + ", \"kapsanmayan\": " + to_string(s.kapsanmayan)
+                    + ", \"aps\": [";
+        for (size_t j = 0; j < s.aps.size(); j++) {
+            const SimAPSonucu& a = s.aps[j];
+            json += string(j ? "," : "") + "{ \"id\": " + to_string(j)
+                  + ", \"kanal\": " + to_string(birey[j].kanal)
+                  + ", \"kullanici\": " + to_string(a.kullanici)
+                  + ", \"verim_mbps\": " + to_string(a.verim_mbps)
+                  + ", \"p50_ms\": " + to_string(a.p50_ms)
+                  + ", \"p99_ms\": " + to_string(a.p99_ms)
+                  + ", \"teslim\": " + to_string(a.teslim)
+                  + ", \"dusen\": " + to_string(a.dusen) + " }";
+        }
+        json += "] }";
+        res.set_content(json, "application/json");
+    });
+
+    // Zaman bütçeli optimizasyon: /optimize?deadline_ms=200
+    svr.Get("/optimize", [&](const httplib::Request& req, httplib::Response& res) {
+        IZ_BOLGE("REST /optimize");
+        double butce = req.has_param("deadline_ms") ? atof(req.get_param_value("deadline_ms").c_str()) : 100.0;
+        if (!(butce > 0 && butce <= ZAMANLI_BUTCE_MAX_MS)) {
+            res.status = 400;
+            res.set_content("{ \"hata\": \"deadline_ms 0..10000 olmali\" }", "application/json");
+            return;
+        }
+        ZamanliSonuc z;
+        {
+            // Kendi bağlamında koşar: yayınlanmış sonuç ve istatistikler
+            // değişmez, okuyucular beklemez. Eşzamanlı istekler sırayla
+            // çalışır, her biri zaten tüm işçi havuzunu kullanır.
+            static mutex optimizasyonKilidi;
+            lock_guard<mutex> kilit(optimizasyonKilidi);
+            RastgeleAkisKapsami kapsam(istekAkisi());
+            CalismaBaglami b;
+            b.durma = durmaAyar;
+            b.ya = yaAyar;
+            z = zamanliOptimizasyon(b, butce);
+        }
+        logYaz(LOG_BILGI, "REST /optimize: butce %.1f ms, skor %.4f, asim %.3f ms", butce, z.skor, z.asim_ms);
+        string json = "{ \"skor\": " + to_string(z.skor)
+                    + ", \"epoch\": " + to_string(z.epoch)
+                    + ", \"degerlendirme\": " + to_string(z.degerlendirme)
+                    + ", \"populasyon\": " + to_string(z.populasyon)
+                    + ", \"sure_ms\": " + to_string(z.sure_ms)
+                    + ", \"asim_ms\": " + to_string(z.asim_ms) + ", \"aps\": [";
+        for (size_t i = 0; i < z.birey.size(); i++) {
+            json += string(i ? "," : "") + "{ \"x\": " + to_string(z.birey[i].x)
+                  + ", \"y\": " + to_string(z.birey[i].y)
+                  + ", \"kanal\": " + to_string(z.birey[i].kanal) + " }";
+        }
+        json += "] }";
+        res.set_content(json, "application/json");
+    });
+
+    // Son epoch'un popülasyon istatistikleri ve kullanıcı talep istatistikleri
+    svr.Get("/stats", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /stats");
+        PopulasyonIstatistigi p = popIstatistik.oku();
+        string json = "{ \"epoch\": " + to_string(p.epoch)
+                    + ", \"ortalama\": " + to_string(p.ortalama)
+                    + ", \"varyans\": " + to_string(p.varyans)
+                    + ", \"en_iyi\": " + to_string(p.en_iyi)
+                    + ", \"tum_en_iyi\": " + to_string(p.tum_en_iyi)
+                    + ", \"degerlendirme\": " + to_string(p.degerlendirme)
+                    + ", \"talep_ortalama\": " + to_string(globalOrtalamaFitness.load())
+                    + ", \"talep_varyans\": " + to_string(talepVaryansi.load()) + " }";
+        res.set_content(json, "application/json");
+    });
+
+    // Prometheus metin biçimi: ilerleme ve faz başına süre / donanım sayaçları
+    svr.Get("/metrics", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /metrics");
+        PopulasyonIstatistigi p = popIstatistik.oku();
+        string m = "# TYPE wifi_ga_degerlendirme_toplam counter\nwifi_ga_degerlendirme_toplam "
+                 + to_string(anaDegerlendirme) + "\n"
+                 + "# TYPE wifi_ga_rest_degerlendirme_toplam counter\nwifi_ga_rest_degerlendirme_toplam "
+                 + to_string(degerlendirmeSayisi - anaDegerlendirme) + "\n"
+                 + "# TYPE wifi_ga_epoch gauge\nwifi_ga_epoch " + to_string(p.epoch) + "\n"
+                 + "# TYPE wifi_ga_en_iyi_skor gauge\nwifi_ga_en_iyi_skor " + to_string(p.tum_en_iyi) + "\n"
+                 + perfMetrikleri();
+        res.set_content(m, "text/plain; version=0.0.4");
+    });
+
+    // En iyi bireyin ısı haritası: /best.png?w=800&h=600&mode=signal|coverage|interference&users=0
+    svr.Get("/best.png", [&](const httplib::Request& req, httplib::Response& res) {
+        IZ_BOLGE("REST /best.png");
+        int w = req.has_param("w") ? atoi(req.get_param_value("w").c_str()) : haritaAyar.genislik;
+        int h = req.has_param("h") ? atoi(req.get_param_value("h").c_str()) : haritaAyar.yukseklik;
+        HaritaKipi kip = haritaAyar.kip;
+        if (req.has_param("mode") && !haritaKipiniCoz(req.get_param_value("mode"), kip)) {
+            res.status = 400;
+            res.set_content("{ \"hata\": \"gecersiz mode\" }", "application/json");
+            return;
+        }
+        if (!haritaBoyutuGecerli(w, h)) {
+            res.status = 400;
+            res.set_content("{ \"hata\": \"boyut 1..4096 ve en fazla 4M piksel olmali\" }", "application/json");
+            return;
+        }
+        static atomic<int> cizimde{0};
+        if (cizimde.fetch_add(1) >= HARITA_ES_ZAMANLI) {
+            cizimde--;
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content("{ \"hata\": \"harita cizimi mesgul\" }", "application/json");
+            return;
+        }
+        struct Birak { ~Birak() { cizimde--; } } birak;
+        bool kullaniciCiz = !req.has_param("users") || req.get_param_value("users") != "0";
+        vector<AP> birey = enIyiKopyasi();
+        int yenilenen = 0;
+        Goruntu g = haritaOnbellegi.ciz(birey, w, h, kip, kullaniciCiz, &yenilenen);
+        res.set_header("X-Yenilenen-Dose", to_string(yenilenen));
+        res.set_content(pngKodla(g), "image/png");
+    });
+
+    // Çalışan sunucudan izleme yakalama: start kaydı açar, stop Chrome trace JSON döndürür
+    svr.Get("/trace/start", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /trace/start");
+        if (!WIFI_IZLEME) { res.status = 501; res.set_content("{ \"hata\": \"izleme derlenmedi\" }", "application/json"); return; }
+        izlemeBaslat();
+        res.set_content("{ \"izleme\": \"basladi\" }", "application/json");
+    });
+
+    svr.Get("/trace/stop", [&](const httplib::Request&, httplib::Response& res) {
+        IZ_BOLGE("REST /trace/stop");
+        res.set_content(izlemeyiDurdur(), "application/json");
+    });
+
     svr.listen("0.0.0.0", 8080); // Hata kontrolü yok
 }
 
 // ------------------------------------------------------
-// Thread Fonksiyonları
+// Canlı Panel (ncurses)
 // ------------------------------------------------------
+// --dashboard ile optimizasyon sürerken ayrı bir thread sabit hızda
+// (PANEL_HZ) ekranı yeniler. Veriler kilitsiz okunur: popülasyon
+// istatistikleri seqlock'tan, değerlendirme sayısı, işçi meşguliyeti ve
+// faz sayaçları atomiklerden. Panel açıkken stdout /dev/null'a yönlendirilir
+// (curses ekranı bozulmasın); kapanınca geri alınır, özet günlükte kalır.
+// Tuşlar: p / boşluk duraklat-devam, s optimizasyonu durdur, q çık (çalışıyorsa durdurur).
 
-void* fitnessThread(void* arg) {
-    while (!dur) {
-        double toplam = 0;
-        for (auto& k : kullanicilar) toplam += k.talep;  // k talep uninitialized olabilir
-        globalOrtalamaFitness = kullanicilar.empty() ? 0 : toplam / kullanicilar.size();
-        sleep(1);
+const int PANEL_HZ = 10;
+const int PANEL_GECMIS = 512;          // Parıltı çizgisi için saklanan epoch
+
+bool panelAktif = false;               // --dashboard
+atomic<bool> optimizasyonBitti{false};
+pthread_t panelThread;
+int panelTty = -1;
+FILE* panelEkran = nullptr;
+
+// Değerleri ' '..'@' arası 10 seviyeye ölçekleyerek tek satırda çizer
+void parilti(int y, const char* etiket, const deque<double>& g, int genislik) {
+    static const char seviye[] = " .:-=+*#%@";
+    mvprintw(y, 1, "%-9s", etiket);
+    if (g.empty()) return;
+    int bas = max(0, (int)g.size() - genislik);
+    double lo = *min_element(g.begin() + bas, g.end()), hi = *max_element(g.begin() + bas, g.end());
+    for (int i = bas; i < (int)g.size(); i++) {
+        int s = hi > lo ? (int)((g[i] - lo) / (hi - lo) * 9 + 0.5) : 5;
+        addch(seviye[s]);
+    }
+    printw(" [%.2f .. %.2f]", lo, hi);
+}
+
+void* panelDongusu(void*) {
+    SCREEN* ekran = newterm(nullptr, panelEkran, stdin);
+    set_term(ekran);
+    cbreak(); noecho(); curs_set(0);
+    timeout(1000 / PANEL_HZ);
+
+    int n = zamanlayici.boyut();
+    deque<double> enIyiGecmis, ortalamaGecmis;
+    vector<uint64_t> oncekiMesgul(n, 0);
+    auto oncekiZaman = chrono::steady_clock::now();
+    uint64_t oncekiDeg = degerlendirmeSayisi;
+    int oncekiEpoch = 0, sonEpoch = -1;
+    double epochHizi = 0, degHizi = 0;
+    vector<double> kullanim(n, 0.0);
+
+    for (;;) {
+        int c = getch();
+        if (c == 'p' || c == ' ') duraklatildi = !duraklatildi;
+        else if (c == 's') durdurIstegi = true;
+        else if (c == 'q') { durdurIstegi = true; break; }
+
+        PopulasyonIstatistigi p = popIstatistik.oku();
+        if (p.epoch != sonEpoch && p.degerlendirme > 0) {
+            sonEpoch = p.epoch;
+            enIyiGecmis.push_back(p.en_iyi);
+            ortalamaGecmis.push_back(p.ortalama);
+            if ((int)enIyiGecmis.size() > PANEL_GECMIS) { enIyiGecmis.pop_front(); ortalamaGecmis.pop_front(); }
+        }
+
+        // Hızlar ve kullanım yaklaşık saniyede bir güncellenir
+        auto simdi = chrono::steady_clock::now();
+        double dt = chrono::duration<double>(simdi - oncekiZaman).count();
+        if (dt >= 1.0) {
+            uint64_t deg = degerlendirmeSayisi;
+            int epochFark = p.epoch - oncekiEpoch;
+            epochHizi = (epochFark >= 0 ? epochFark : p.epoch + 1) / dt;   // Yeni aşamada sayaç sıfırlanır
+            degHizi = (deg - oncekiDeg) / dt;
+            for (int w = 0; w < n; w++) {
+                uint64_t m = zamanlayici.kuyruklar[w]->mesgulNs;
+                kullanim[w] = min(1.0, (m - oncekiMesgul[w]) / (dt * 1e9));
+                oncekiMesgul[w] = m;
+            }
+            oncekiZaman = simdi; oncekiDeg = deg; oncekiEpoch = p.epoch;
+        }
+
+        erase();
+        const char* durum = optimizasyonBitti ? "BITTI" : durdurIstegi ? "DURDURULUYOR" : duraklatildi ? "DURAKLATILDI" : "CALISIYOR";
+        mvprintw(0, 1, "WiFi AP GA - canli panel");
+        mvprintw(0, max(1, COLS - (int)strlen(durum) - 3), "[%s]", durum);
+        mvprintw(2, 1, "Epoch: %-8d Epoch/sn: %-9.1f Degerlendirme: %llu (%.0f/sn)",
+                 p.epoch, epochHizi, (unsigned long long)degerlendirmeSayisi.load(), degHizi);
+        mvprintw(3, 1, "En iyi: %-12.4f Epoch en iyi: %-12.4f Ortalama: %-12.4f Sapma: %.4f",
+                 p.tum_en_iyi, p.en_iyi, p.ortalama, sqrt(p.varyans));
+        int genislik = max(10, COLS - 40);
+        parilti(5, "En iyi", enIyiGecmis, genislik);
+        parilti(6, "Ortalama", ortalamaGecmis, genislik);
+
+        int y = 8;
+        mvprintw(y++, 1, "Isciler (%d):", n);
+        for (int w = 0; w < n && y < LINES - 5; w++) {
+            int dolu = (int)(kullanim[w] * 20 + 0.5);
+            mvprintw(y++, 3, "isci %-3d [%-20.*s] %3.0f%%  gorev %llu", w, dolu, "####################",
+                     kullanim[w] * 100, (unsigned long long)zamanlayici.kuyruklar[w]->gorevSayisi.load());
+        }
+
+        y++;
+        if (perfKullanilabilir && perfOlayVar[PO_ONBELLEK_BASVURU] && perfOlayVar[PO_ONBELLEK_KACIRMA]) {
+            mvprintw(y, 1, "Onbellek isabeti:");
+            for (int f = 0; f < FAZ_SAYISI; f++) {
+                uint64_t bas = fazToplam[f].olay[PO_ONBELLEK_BASVURU], kac = fazToplam[f].olay[PO_ONBELLEK_KACIRMA];
+                if (bas > 0) printw("  %s %.1f%%", FAZ_ADI[f], 100.0 * (1.0 - (double)kac / bas));
+            }
+        } else {
+            mvprintw(y, 1, "Onbellek isabeti: yok (%s)", perfAktif ? perfNeden.c_str() : "--perf verilmedi");
+        }
+        mvprintw(LINES - 1, 1, "p: duraklat/devam   s: durdur   q: cik");
+        refresh();
     }
+    endwin();
+    delscreen(ekran);
     return nullptr;
 }
 
+// Terminal yoksa panel açılmaz; false döner
+bool panelBaslat() {
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+        fprintf(stderr, "Uyari: panel icin terminal gerekli, --dashboard yok sayildi\n");
+        return false;
+    }
+    fflush(stdout);
+    panelTty = dup(STDOUT_FILENO);
+    panelEkran = fdopen(panelTty, "w");
+    int bos = open("/dev/null", O_WRONLY);
+    dup2(bos, STDOUT_FILENO);
+    close(bos);
+    pthread_create(&panelThread, nullptr, panelDongusu, nullptr);
+    return true;
+}
+
+// Kullanıcı q ile çıkana kadar bekler, stdout'u geri alır
+void panelBitir() {
+    pthread_join(panelThread, nullptr);
+    fflush(stdout);
+    dup2(panelTty, STDOUT_FILENO);
+    fclose(panelEkran);
+}
+
 // ------------------------------------------------------
-// Terminal Menüsü (ncurses)
+// Sıcak Başlangıç (Önceki Yerleşimden Tohumlama)
 // ------------------------------------------------------
+// Kullanıcı anketi az değiştiğinde optimizasyon rastgele bireyler yerine
+// önceki en iyi yerleşimden başlar. --warm-start db son çalıştırmanın
+// yerlesim satırlarını (toplu modda aynı adlı senaryonun son sonucunu),
+// --warm-start DOSYA ise --save-snapshot ile yazılmış ikili anlık görüntüyü
+// okur. Tohum popülasyona aynen girer; yuvaların TOHUM_VARYANT_ORANI kadarı
+// mutasyonlu kopyalarıdır, kalanı çeşitlilik için rastgele kalır. Küçük
+// anket farklarında durgunluk ölçütüne çok daha erken ulaşılır.
 
-void terminalMenu() {
-    initscr(); cbreak(); noecho();
-    int choice = 0;
-    while (choice != '3') {
-        clear();
-        mvprintw(1, 1, "1) Genetik Algoritma Baslat");
-        mvprintw(2, 1, "2) Log dosyasini goster");
-        mvprintw(3, 1, "3) Cikis");
-        refresh();
-        choice = getch();
-        switch (choice) {
-            case '1': mvprintw(5,1,"GA calisiyor..."); refresh(); sleep(1); break;
-            case '2': mvprintw(5,1,"Log dosyasi: optimal.txt"); refresh(); sleep(1); break;
-            default: break;
+struct SicakBaslangicAyarlari {
+    string kaynak;   // --warm-start: "db" ya da anlık görüntü dosyası
+    string kayit;    // --save-snapshot
+};
+SicakBaslangicAyarlari sicakAyar;
+vector<vector<AP>> sicakTohumlar;   // Boşsa soğuk başlangıç
+
+// Anlık görüntü: başlık ardından AP kayıtları (yerel bayt sırası)
+const char ANLIK_SIHIR[4] = {'W', 'G', 'A', 'S'};
+const uint32_t ANLIK_SURUM = 1;
+const uint32_t ANLIK_AP_SINIRI = 1 << 16;
+
+struct AnlikBaslik {
+    char sihir[4];
+    uint32_t surum, adet, kullanici;
+    double skor;
+};
+
+struct AnlikAP {
+    int32_t x, y, kanal;
+    float talep;
+    char label[32];
+};
+static_assert(sizeof(AnlikBaslik) == 24 && sizeof(AnlikAP) == 48, "anlik goruntu duzeni");
+
+bool anlikGoruntuYaz(const char* yol, const vector<AP>& birey, double skor) {
+    // Önce geçici dosyaya yazılır: yarım kalan yazım eski görüntüyü bozmaz
+    string gecici = string(yol) + ".tmp";
+    FILE* fp = fopen(gecici.c_str(), "wb");
+    if (!fp) return false;
+    AnlikBaslik b;
+    memcpy(b.sihir, ANLIK_SIHIR, sizeof(b.sihir));
+    b.surum = ANLIK_SURUM;
+    b.adet = (uint32_t)birey.size();
+    b.kullanici = (uint32_t)kullanicilar.size();
+    b.skor = skor;
+    bool tamam = fwrite(&b, sizeof(b), 1, fp) == 1;
+    for (size_t i = 0; tamam && i < birey.size(); i++) {
+        AnlikAP k = {};
+        k.x = birey[i].x;
+        k.y = birey[i].y;
+        k.kanal = birey[i].kanal;
+        k.talep = (float)birey[i].talep;
+        snprintf(k.label, sizeof(k.label), "%s", birey[i].label);
+        tamam = fwrite(&k, sizeof(k), 1, fp) == 1;
+    }
+    tamam = fclose(fp) == 0 && tamam;
+    if (tamam) tamam = rename(gecici.c_str(), yol) == 0;
+    if (!tamam) remove(gecici.c_str());
+    return tamam;
+}
+
+bool anlikGoruntuOku(const char* yol, vector<AP>& birey) {
+    birey.clear();
+    FILE* fp = fopen(yol, "rb");
+    if (!fp) return false;
+    AnlikBaslik b;
+    bool tamam = fread(&b, sizeof(b), 1, fp) == 1 && memcmp(b.sihir, ANLIK_SIHIR, sizeof(b.sihir)) == 0 &&
+                 b.surum == ANLIK_SURUM && b.adet <= ANLIK_AP_SINIRI;
+    for (uint32_t i = 0; tamam && i < b.adet; i++) {
+        AnlikAP k;
+        if (!(tamam = fread(&k, sizeof(k), 1, fp) == 1)) break;
+        AP a;
+        a.x = k.x;
+        a.y = k.y;
+        a.kanal = k.kanal;
+        a.talep = k.talep;
+        snprintf(a.label, sizeof(a.label), "%.*s", (int)sizeof(k.label), k.label);
+        birey.push_back(a);
+    }
+    fclose(fp);
+    if (!tamam) birey.clear();
+    return !birey.empty();
+}
+
+// Sütun 'ilk'ten itibaren x, y, kanal, label, talep
+AP satirdanAP(sqlite3_stmt* st, int ilk) {
+    AP a;
+    a.x = sqlite3_column_int(st, ilk);
+    a.y = sqlite3_column_int(st, ilk + 1);
+    a.kanal = sqlite3_column_int(st, ilk + 2);
+    const unsigned char* etiket = sqlite3_column_text(st, ilk + 3);
+    snprintf(a.label, sizeof(a.label), "%s", etiket ? (const char*)etiket : "");
+    a.talep = sqlite3_column_double(st, ilk + 4);
+    return a;
+}
+
+// yerlesim tablosunda çalıştırma kimliği yok: her çalıştırma ap_id 0'dan
+// başlayan bir blok ekler, son blok rowid sırasıyla geriye doğru okunur
+bool yerlesimdenOku(vector<AP>& birey) {
+    birey.clear();
+    sqlite3_stmt* st = nullptr;
+    if (!db || sqlite3_prepare_v2(db, "SELECT ap_id, x, y, kanal, label, talep FROM yerlesim ORDER BY rowid DESC;",
+                                  -1, &st, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(st);
+        return false;
+    }
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        birey.push_back(satirdanAP(st, 1));
+        if (sqlite3_column_int(st, 0) == 0) break;
+    }
+    sqlite3_finalize(st);
+    reverse(birey.begin(), birey.end());
+    return !birey.empty();
+}
+
+// Toplu modda aynı adlı senaryonun en son yazılan sonucu
+bool senaryodanOku(const char* ad, vector<AP>& birey) {
+    birey.clear();
+    sqlite3_stmt* st = nullptr;
+    if (!db || sqlite3_prepare_v2(db, "SELECT x, y, kanal, label, talep FROM senaryo_ap WHERE senaryo_id = "
+                                      "(SELECT MAX(id) FROM senaryo WHERE ad = ?) ORDER BY ap_id;",
+                                  -1, &st, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(st);
+        return false;
+    }
+    sqlite3_bind_text(st, 1, ad, -1, SQLITE_TRANSIENT);
+    while (sqlite3_step(st) == SQLITE_ROW) birey.push_back(satirdanAP(st, 0));
+    sqlite3_finalize(st);
+    return !birey.empty();
+}
+
+// Okunan yerleşimi alana ve geçerli aralıklara sıkıştırır; AP sayısı
+// [AP_MIN, AP_MAX] dışındaysa kırpılır ya da rastgele AP'lerle tamamlanır
+void tohumuDuzelt(vector<AP>& birey) {
+    for (AP& a : birey) {
+        a.x = alanaSinirla(a.x);
+        a.y = alanaSinirla(a.y);
+        if (a.kanal < 1 || a.kanal > KANAL_SAYISI) a.kanal = randint(1, KANAL_SAYISI + 1);
+    }
+    if ((int)birey.size() > AP_MAX) birey.resize(AP_MAX);
+    while ((int)birey.size() < AP_MIN) {
+        AP a;
+        rastgele_ap(a);
+        birey.push_back(a);
+    }
+}
+
+// Seçilen kaynaktan sicakTohumlar'ı doldurur; bulunamazsa soğuk başlangıç.
+// 'senaryoAd' toplu modda veritabanı kaynağını o senaryoya daraltır.
+bool sicakTohumlariHazirla(const char* senaryoAd) {
+    sicakTohumlar.clear();
+    if (sicakAyar.kaynak.empty()) return false;
+    vector<AP> birey;
+    bool vt = sicakAyar.kaynak == "db";
+    bool tamam = vt ? (senaryoAd ? senaryodanOku(senaryoAd, birey) : yerlesimdenOku(birey))
+                    : anlikGoruntuOku(sicakAyar.kaynak.c_str(), birey);
+    const char* kaynak = vt ? (senaryoAd ? "senaryo_ap" : "yerlesim") : sicakAyar.kaynak.c_str();
+    if (!tamam) {
+        logYaz(LOG_UYARI, "Sicak baslangic: onceki yerlesim bulunamadi (%s), rastgele baslaniyor", kaynak);
+        return false;
+    }
+    size_t okunan = birey.size();
+    tohumuDuzelt(birey);
+    sicakTohumlar.push_back(move(birey));
+    printf("Sicak baslangic: %zu AP'lik onceki yerlesim tohum (%s)\n", okunan, kaynak);
+    logYaz(LOG_BILGI, "Sicak baslangic: %zu AP'lik onceki yerlesim tohum olarak yuklendi (%s)", okunan, kaynak);
+    return true;
+}
+
+// ------------------------------------------------------
+// Toplu Senaryo Çalıştırıcı
+// ------------------------------------------------------
+// --batch MANIFEST ile birçok bina tek süreçte optimize edilir. Manifest her
+// satırda bir senaryo içerir: "konfig_dosyasi [ad]" (# yorum; göreli yollar
+// manifestin dizinine göredir). GA durumu global olduğundan senaryolar
+// sırayla optimize edilir ve her biri paylaşılan zamanlayıcının tüm
+// işçilerini kullanır. Sonraki senaryoların dosyaları aynı zamanlayıcıda
+// arka planda okunur; önceden yüklenen veri --batch-mem-mb bütçesini aşmaz
+// (bütçeden büyük tek senaryo yalnız başına yüklenir). Zamanlayıcı,
+// veritabanı bağlantısı, hazır SQL ifadeleri, kullanıcı kümesi ve popülasyon
+// havuzları senaryolar arasında yeniden kullanılır. Her senaryo aynı tohumla
+// başlar; sonucu (özet ve AP'ler) tek bir transaction içinde yazılır.
+
+struct TopluAyarlari {
+    string manifest;              // --batch
+    size_t bellek_bayt = 512ULL << 20;   // --batch-mem-mb
+};
+TopluAyarlari topluAyar;
+
+// Konfig satırı başına yaklaşık bayt ve kullanıcı başına bellek (ham liste + tam küme)
+const size_t KONFIG_SATIR_BAYT = 12;
+const size_t KULLANICI_BELLEK = sizeof(AP) + 3 * sizeof(double) + sizeof(int);
+
+struct Senaryo {
+    string ad, dosya;
+    size_t tahmini = 0;           // Yüklenmeden önceki bellek tahmini (bayt)
+    vector<AP> kullanici;
+    bool yuklendi = false;
+    GorevGrubu grup;
+};
+
+bool manifestOku(const string& yol, vector<unique_ptr<Senaryo>>& liste) {
+    FILE* fp = fopen(yol.c_str(), "r");
+    if (!fp) return false;
+    string dizin = yol.find('/') != string::npos ? yol.substr(0, yol.rfind('/') + 1) : "";
+    char satir[1024], dosyaAd[512], adAd[256];
+    while (fgets(satir, sizeof(satir), fp) != nullptr) {
+        int alan = sscanf(satir, "%511s %255s", dosyaAd, adAd);
+        if (alan < 1 || dosyaAd[0] == '#') continue;
+        string dosya = dosyaAd, ad = alan > 1 ? adAd : "";
+        if (dosya[0] != '/') dosya = dizin + dosya;
+        if (ad.empty()) {
+            ad = dosya.substr(dosya.rfind('/') + 1);
+            if (ad.find('.') != string::npos) ad = ad.substr(0, ad.rfind('.'));
         }
+        unique_ptr<Senaryo> s(new Senaryo());
+        s->ad = ad;
+        s->dosya = dosya;
+        struct stat st;
+        s->tahmini = stat(dosya.c_str(), &st) == 0 ? (size_t)st.st_size / KONFIG_SATIR_BAYT * KULLANICI_BELLEK : 0;
+        liste.push_back(move(s));
     }
-    endwin();
+    fclose(fp);
+    return true;
+}
+
+// Senaryo sonucu için hazır ifadeler; bağlantı boyunca bir kez hazırlanır
+struct SenaryoYazici {
+    sqlite3_stmt* senaryoSt = nullptr;
+    sqlite3_stmt* apSt = nullptr;
+
+    bool hazirla() {
+        if (!db) return false;
+        sqlite3_exec(db,
+            "CREATE TABLE IF NOT EXISTS senaryo ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, ad TEXT, konfig TEXT, kullanici INTEGER, skor REAL, "
+            "epoch INTEGER, degerlendirme INTEGER, sure_sn REAL, neden TEXT, zaman TEXT DEFAULT CURRENT_TIMESTAMP);"
+            "CREATE TABLE IF NOT EXISTS senaryo_ap ("
+            "senaryo_id INTEGER, ap_id INTEGER, x INTEGER, y INTEGER, kanal INTEGER, label TEXT, talep REAL);",
+            nullptr, 0, nullptr);
+        return sqlite3_prepare_v2(db, "INSERT INTO senaryo (ad, konfig, kullanici, skor, epoch, degerlendirme, sure_sn, neden) "
+                                      "VALUES (?, ?, ?, ?, ?, ?, ?, ?);", -1, &senaryoSt, nullptr) == SQLITE_OK &&
+               sqlite3_prepare_v2(db, "INSERT INTO senaryo_ap (senaryo_id, ap_id, x, y, kanal, label, talep) "
+                                      "VALUES (?, ?, ?, ?, ?, ?, ?);", -1, &apSt, nullptr) == SQLITE_OK;
+    }
+
+    bool yaz(const Senaryo& s, size_t kullanici) {
+        sqlite3_exec(db, "BEGIN;", nullptr, 0, nullptr);
+        sqlite3_bind_text(senaryoSt, 1, s.ad.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(senaryoSt, 2, s.dosya.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(senaryoSt, 3, (sqlite3_int64)kullanici);
+        sqlite3_bind_double(senaryoSt, 4, en_iyi_skor);
+        sqlite3_bind_int(senaryoSt, 5, sonOzet.epoch);
+        sqlite3_bind_int64(senaryoSt, 6, (sqlite3_int64)sonOzet.degerlendirme);
+        sqlite3_bind_double(senaryoSt, 7, sonOzet.sure_sn);
+        sqlite3_bind_text(senaryoSt, 8, sonOzet.neden, -1, SQLITE_TRANSIENT);
+        bool tamam = sqlite3_step(senaryoSt) == SQLITE_DONE;
+        sqlite3_reset(senaryoSt);
+        sqlite3_int64 id = sqlite3_last_insert_rowid(db);
+        for (size_t i = 0; tamam && i < en_iyi_birey.size(); i++) {
+            const AP& a = en_iyi_birey[i];
+            sqlite3_bind_int64(apSt, 1, id);
+            sqlite3_bind_int(apSt, 2, (int)i);
+            sqlite3_bind_int(apSt, 3, a.x);
+            sqlite3_bind_int(apSt, 4, a.y);
+            sqlite3_bind_int(apSt, 5, a.kanal);
+            sqlite3_bind_text(apSt, 6, a.label, -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(apSt, 7, a.talep);
+            tamam = sqlite3_step(apSt) == SQLITE_DONE;
+            sqlite3_reset(apSt);
+        }
+        sqlite3_exec(db, tamam ? "COMMIT;" : "ROLLBACK;", nullptr, 0, nullptr);
+        return tamam;
+    }
+
+    ~SenaryoYazici() {
+        sqlite3_finalize(senaryoSt);
+        sqlite3_finalize(apSt);
+    }
+};
+
+// Seçilen modu çalıştırır, ardından kanal çözücü, kesin yeniden
+// değerlendirme ve simülasyon son işlemlerini uygular. Pareto kümesi
+// üretildiyse true döner.
+bool optimizasyonuYurut() {
+    bool paretoYaz = false;
+    const vector<vector<AP>>* tohumlar = sicakTohumlar.empty() ? nullptr : &sicakTohumlar;
+    CalismaBaglami b = anaBaglam();
+    if (sonTarihMs > 0) {
+        ZamanliSonuc z = zamanliOptimizasyon(b, sonTarihMs, tohumlar);
+        printf("Zamanli: populasyon %d, asim %.3f ms\n", z.populasyon, z.asim_ms);
+    } else if (!asamalar.empty()) {
+        cokCozunurlukluCalistir(b, tohumlar);
+    } else if (calismaModu == MOD_NSGA2) {
+        nsga2Calistir(b, tohumlar);
+        paretoYaz = true;
+    } else {
+        gaCalistir(b, POP_BOYUTU, tohumlar);
+    }
+    printf("Durdu (%s): %d epoch, %llu degerlendirme, %.3f sn, cesitlilik %.2f\n",
+           b.ozet.neden, b.ozet.epoch, (unsigned long long)b.ozet.degerlendirme,
+           b.ozet.sure_sn, b.ozet.cesitlilik);
+    logYaz(LOG_BILGI, "Durdu (%s): %d epoch, %llu degerlendirme, %.3f sn, skor %.4f",
+           b.ozet.neden, b.ozet.epoch, (unsigned long long)b.ozet.degerlendirme, b.ozet.sure_sn, b.en_iyi_skor);
+    if (kanalCozucuModu != KC_KAPALI && !b.en_iyi_birey.empty()) {
+        b.en_iyi_skor = kanallariCozVeGuncelle(b.en_iyi_birey.data(), (int)b.en_iyi_birey.size(), b.en_iyi_skor);
+    }
+    if (kumeAyar.kesin_son && aktifKume != &tamKume && !b.en_iyi_birey.empty()) {
+        aktifKume = &tamKume;
+        double yaklasik = b.en_iyi_skor;
+        b.en_iyi_skor = uygunluk(b.en_iyi_birey);
+        printf("Kesin yeniden degerlendirme: %.4f (kumelenmis %.4f)\n", b.en_iyi_skor, yaklasik);
+    }
+    if (simAyar.sure > 0 && !b.en_iyi_birey.empty()) {
+        SimSonucu sim = agSimulasyonu(b.en_iyi_birey, simAyar.sure, simAyar.tekrar);
+        simulasyonRaporu(b.en_iyi_birey, sim, simAyar.sure, simAyar.tekrar);
+    }
+    sonucuYayinla(b);
+    return paretoYaz;
+}
+
+// Bir senaryonun kullanıcılarını global duruma kurar; tek çalıştırmadaki sırayı izler
+void senaryoyuKur(Senaryo& s) {
+    rastgeleBaslat(anaTohum);
+    kullanicilar.clear();
+    talepIst = TalepIstatistigi();
+    for (AP& k : s.kullanici) {
+        k.kanal = randint(1, 14);
+        kullaniciEkle(k);
+    }
+    vector<AP>().swap(s.kullanici);
+    if (kullanicilar.empty()) rastgeleKullanicilarEkle();
+    kullaniciKumesiniHazirla();
+    optimizasyonuSifirla();
+    paretoKumesi.clear();
+    sicakTohumlariHazirla(s.ad.c_str());
+}
+
+int topluCalistir() {
+    vector<unique_ptr<Senaryo>> liste;
+    if (!manifestOku(topluAyar.manifest, liste)) {
+        fprintf(stderr, "Manifest okunamadi: %s\n", topluAyar.manifest.c_str());
+        return 1;
+    }
+    SenaryoYazici yazici;
+    if (!yazici.hazirla()) logYaz(LOG_UYARI, "Toplu mod: veritabani hazir degil, sonuclar yazilmayacak");
+
+    size_t ayrilan = 0, sonraki = 0;   // Önceden yüklenen bellek ve sıradaki yüklenecek senaryo
+    int basarili = 0;
+    auto bas = chrono::steady_clock::now();
+    for (size_t i = 0; i < liste.size(); i++) {
+        // Bütçe elverdikçe ileriki senaryoları arka planda yükle
+        while (sonraki < liste.size() && (sonraki == i || ayrilan + liste[sonraki]->tahmini <= topluAyar.bellek_bayt)) {
+            Senaryo* s = liste[sonraki].get();
+            ayrilan += s->tahmini;
+            zamanlayici.gonder(s->grup, [s] { s->yuklendi = konfigYukle(s->dosya.c_str(), s->kullanici); });
+            sonraki++;
+        }
+        Senaryo& s = *liste[i];
+        zamanlayici.bekle(s.grup);
+        ayrilan -= s.tahmini;
+        if (!s.yuklendi) {
+            logYaz(LOG_UYARI, "Senaryo %s: konfig okunamadi (%s)", s.ad.c_str(), s.dosya.c_str());
+            continue;
+        }
+        size_t kullanici = s.kullanici.size();
+        senaryoyuKur(s);
+        optimizasyonuYurut();
+        bool yazildi = db && yazici.yaz(s, kullanicilar.size());
+        basarili += yazildi || !db;
+        printf("Senaryo %zu/%zu %s: %zu kullanici, skor %.4f, %d epoch, %.3f sn%s\n", i + 1, liste.size(),
+               s.ad.c_str(), kullanici, en_iyi_skor, sonOzet.epoch, sonOzet.sure_sn, yazildi ? "" : " (yazilmadi)");
+        logYaz(LOG_BILGI, "Senaryo %s: skor %.4f, %d epoch, %.3f sn", s.ad.c_str(), en_iyi_skor, sonOzet.epoch, sonOzet.sure_sn);
+    }
+    printf("Toplu: %d/%zu senaryo, %.2f sn\n", basarili, liste.size(),
+           chrono::duration<double>(chrono::steady_clock::now() - bas).count());
+    return basarili == (int)liste.size() ? 0 : 1;
 }
 
 // ------------------------------------------------------
-// Görsel Oluşturma (OpenCV Stub)
+// Komut Satırı Argümanları
 // ------------------------------------------------------
 
-void gorselOlustur(const vector<AP>& ekip) {
-#ifdef USE_OPENCV
-    cv::Mat img(100, 100, CV_8UC3, cv::Scalar(255,255,255));
-    for (auto& k : ekip) {
-        if (k.x >= 0 && k.x < 100 && k.y >= 0 && k.y < 100) {
-            cv::circle(img, cv::Point(k.x, k.y), 3, cv::Scalar(0,0,255), -1);
+void kullanimYazdir(const char* prog) {
+    printf("Kullanim: %s [secenekler]\n"
+           "  --channel-rate R   AP basina kanal mutasyonu olasiligi (varsayilan 0.05)\n"
+           "  --gauss-rate R     AP basina Gauss konum mutasyonu olasiligi, 0 = kapali\n"
+           "  --gauss-sigma S    Gauss adiminin baslangic sigmasi\n"
+           "  --move-rate R      AP basina yerel kaydirma olasiligi, 0 = kapali\n"
+           "  --move-step N      Yerel kaydirmanin baslangic yaricapi\n"
+           "  --no-adaptive      1/5 basari kurali ile adim ayarini kapat\n"
+           "  --population N     Populasyon boyutu (varsayilan AP sayisi)\n"
+           "  --selection Y      elite | tournament | rank | roulette\n"
+           "  --tournament-size N  Turnuva boyutu (varsayilan 3)\n"
+           "  --elites N         Dogrudan aktarilan elit sayisi (varsayilan 2)\n"
+           "  --crossover Y      single | uniform | two-point | cut-plane\n"
+           "  --seed N           Rastgele tohum (verilmezse random_device)\n"
+           "  --mode M           ga (tek amacli) | nsga2 (Pareto kumesi)\n"
+           "  --min-aps N        Degisken genom: en az AP sayisi\n"
+           "  --max-aps N        Degisken genom: en fazla AP sayisi\n"
+           "  --ap-cost C        Uygunluktan AP basina dusulen maliyet\n"
+           "  --throughput-weight W  Hava suresi tahmininden verime (Mbps) uygunlukta W agirligi ver\n"
+           "  --local-search Y   off | hc (tepe tirmanma) | sa (tavlama)\n"
+           "  --ls-elites N      Her epoch yerel arama yapilan elit sayisi\n"
+           "  --ls-budget N      Epoch basina yerel arama degerlendirme butcesi\n"
+           "  --channel-solver Y off | best (son islem) | elites (her epoch, GA yalnizca konum arar)\n"
+           "  --epochs N         En fazla epoch (varsayilan 100)\n"
+           "  --stall N          N epoch iyilesme yoksa dur\n"
+           "  --target F         Bu skora ulasinca dur\n"
+           "  --time-limit S     Duvar saati butcesi (saniye)\n"
+           "  --max-evals N      Uygunluk degerlendirme butcesi\n"
+           "  --min-diversity D  Farkli genom orani D'nin altina inerse dur\n"
+           "  --deadline-ms T    Zaman butceli mod: T ms icinde en iyi sonucu dondur\n"
+           "  --cluster Y        none | grid | kmeans: kullanicilari agirlikli noktalara topla\n"
+           "  --cluster-res H    Izgara hucre kenari (varsayilan 1)\n"
+           "  --cluster-eps E    Kumelemede izin verilen en buyuk konum kaymasi\n"
+           "  --cluster-k K      k-means kume sayisi (varsayilan 1000)\n"
+           "  --exact-final      En iyi bireyi sonda tum kullanicilarla yeniden degerlendir\n"
+           "  --multires SPEC    Kabadan inceye asamalar: h:populasyon:epoch,... (h=0 tam kume)\n"
+           "  --eval-threads N   Tek birey degerlendirmesini N thread ile kullanici dilimlerine bol\n"
+           "  --threads N        Gorev zamanlayicisi isci sayisi (varsayilan: CPU sayisi)\n"
+           "  --pin              Iscileri NUMA dugumlerine gore CPU'lara sabitle\n"
+           "  --log-level L      ayrinti | bilgi | uyari | hata | off (varsayilan bilgi)\n"
+           "  --log-file YOL     Gunluk dosyasi (varsayilan log.txt)\n"
+           "  --log-format F     json (JSON satirlari) | bin (ikili kayit)\n"
+           "  --log-rotate-mb M  Dosya M MB'i gecince dondur (varsayilan 10)\n"
+           "  --trace DOSYA      Optimizasyonu izle, Chrome trace JSON olarak DOSYA'ya yaz\n"
+           "  --perf             Faz basina donanim sayaclari (perf_event_open)\n"
+           "  --bench-json DOSYA Calisma ozeti ve faz olcumlerini JSON olarak yaz\n"
+           "  --dashboard        Calisirken canli ncurses paneli (p duraklat, s durdur, q cik)\n"
+           "  --heatmap DOSYA    En iyi bireyin haritasi (.png ya da .ppm; varsayilan kullanici_haritasi.png)\n"
+           "  --heatmap-size WxH Harita cozunurlugu (varsayilan 512x512)\n"
+           "  --heatmap-mode K   signal | coverage | interference\n"
+           "  --simulate S       Sonda en iyi yerlesimi S saniyelik CSMA/CA ag simulasyonuyla dogrula\n"
+           "  --sim-reps N       Bagimsiz simulasyon tekrari (varsayilan 4)\n"
+           "  --batch MANIFEST   Manifestteki her konfig icin ayri optimizasyon (satir: dosya [ad])\n"
+           "  --batch-mem-mb N   Toplu modda onceden yuklenen senaryolarin bellek butcesi (varsayilan 512)\n"
+           "  --warm-start K     Onceki yerlesimden basla: db (yerlesim tablosu; toplu modda ayni adli senaryo)\n"
+           "                     ya da --save-snapshot ile yazilmis anlik goruntu dosyasi\n"
+           "  --save-snapshot D  En iyi yerlesimi ikili anlik goruntu olarak D'ye yaz\n",
+           prog);
+}
+
+void argumanlariIsle(int argc, char* argv[]) {
+    random_device rd;
+    uint64_t tohum = ((uint64_t)rd() << 32) | rd();
+    enum { SEC_TOPLU_BELLEK = 256, SEC_SICAK_BASLANGIC, SEC_ANLIK_KAYIT };   // Kısa harfi olmayan uzun seçenekler
+    static const option secenekler[] = {
+        {"channel-rate", required_argument, nullptr, 'c'},
+        {"gauss-rate",   required_argument, nullptr, 'g'},
+        {"gauss-sigma",  required_argument, nullptr, 's'},
+        {"move-rate",    required_argument, nullptr, 'm'},
+        {"move-step",    required_argument, nullptr, 'k'},
+        {"no-adaptive",  no_argument,       nullptr, 'A'},
+        {"population",   required_argument, nullptr, 'p'},
+        {"selection",    required_argument, nullptr, 'S'},
+        {"tournament-size", required_argument, nullptr, 'T'},
+        {"elites",       required_argument, nullptr, 'E'},
+        {"crossover",    required_argument, nullptr, 'X'},
+        {"seed",         required_argument, nullptr, 'R'},
+        {"mode",         required_argument, nullptr, 'M'},
+        {"min-aps",      required_argument, nullptr, 'n'},
+        {"max-aps",      required_argument, nullptr, 'N'},
+        {"ap-cost",      required_argument, nullptr, 'C'},
+        {"throughput-weight", required_argument, nullptr, 'b'},
+        {"local-search", required_argument, nullptr, 'L'},
+        {"ls-elites",    required_argument, nullptr, 'l'},
+        {"ls-budget",    required_argument, nullptr, 'B'},
+        {"channel-solver", required_argument, nullptr, 'K'},
+        {"epochs",       required_argument, nullptr, 'e'},
+        {"stall",        required_argument, nullptr, 'W'},
+        {"target",       required_argument, nullptr, 't'},
+        {"time-limit",   required_argument, nullptr, 'Z'},
+        {"max-evals",    required_argument, nullptr, 'V'},
+        {"min-diversity", required_argument, nullptr, 'D'},
+        {"deadline-ms",  required_argument, nullptr, 'd'},
+        {"cluster",      required_argument, nullptr, 'u'},
+        {"cluster-res",  required_argument, nullptr, 'r'},
+        {"cluster-eps",  required_argument, nullptr, 'o'},
+        {"cluster-k",    required_argument, nullptr, 'q'},
+        {"exact-final",  no_argument,       nullptr, 'x'},
+        {"multires",     required_argument, nullptr, 'P'},
+        {"eval-threads", required_argument, nullptr, 'j'},
+        {"threads",      required_argument, nullptr, 'w'},
+        {"pin",          no_argument,       nullptr, 'a'},
+        {"log-level",    required_argument, nullptr, 'v'},
+        {"log-file",     required_argument, nullptr, 'f'},
+        {"log-format",   required_argument, nullptr, 'F'},
+        {"log-rotate-mb", required_argument, nullptr, 'O'},
+        {"trace",        required_argument, nullptr, 'I'},
+        {"perf",         no_argument,       nullptr, 'H'},
+        {"bench-json",   required_argument, nullptr, 'J'},
+        {"dashboard",    no_argument,       nullptr, 'G'},
+        {"heatmap",      required_argument, nullptr, 'Q'},
+        {"heatmap-size", required_argument, nullptr, 'U'},
+        {"heatmap-mode", required_argument, nullptr, 'Y'},
+        {"simulate",     required_argument, nullptr, 'i'},
+        {"sim-reps",     required_argument, nullptr, 'y'},
+        {"batch",        required_argument, nullptr, 'z'},
+        {"batch-mem-mb", required_argument, nullptr, SEC_TOPLU_BELLEK},
+        {"warm-start",   required_argument, nullptr, SEC_SICAK_BASLANGIC},
+        {"save-snapshot", required_argument, nullptr, SEC_ANLIK_KAYIT},
+        {"help",         no_argument,       nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    int c;
+    while ((c = getopt_long(argc, argv, "h", secenekler, nullptr)) != -1) {
+        switch (c) {
+            case 'c': mutAyar.kanal_orani = atof(optarg); break;
+            case 'g': mutAyar.gauss_orani = atof(optarg); break;
+            case 's': mutAyar.gauss_sigma = atof(optarg); break;
+            case 'm': mutAyar.yerel_orani = atof(optarg); break;
+            case 'k': mutAyar.yerel_adim = atoi(optarg); break;
+            case 'A': mutAyar.adaptif = false; break;
+            case 'p': POP_BOYUTU = atoi(optarg); break;
+            case 'S':
+                if (!secimYonteminiCoz(optarg, secimAyar.yontem)) {
+                    fprintf(stderr, "Bilinmeyen secim yontemi: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'T': secimAyar.turnuva_boyutu = max(1, atoi(optarg)); break;
+            case 'E': secimAyar.elit_sayisi = max(1, atoi(optarg)); break;
+            case 'X':
+                if (!caprazYonteminiCoz(optarg, caprazYontem)) {
+                    fprintf(stderr, "Bilinmeyen caprazlama yontemi: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'R': tohum = strtoull(optarg, nullptr, 0); break;
+            case 'n': AP_MIN = max(1, atoi(optarg)); break;
+            case 'N': AP_MAX = max(1, atoi(optarg)); break;
+            case 'C': AP_MALIYETI = atof(optarg); break;
+            case 'b': VERIM_AGIRLIGI = atof(optarg); break;
+            case 'L':
+                if (!yerelAramaYonteminiCoz(optarg, yaAyar.yontem)) {
+                    fprintf(stderr, "Bilinmeyen yerel arama: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'l': yaAyar.elit_sayisi = max(1, atoi(optarg)); break;
+            case 'B': yaAyar.butce = max(0, atoi(optarg)); break;
+            case 'e': durmaAyar.max_epoch = max(1, atoi(optarg)); break;
+            case 'W': durmaAyar.durgunluk = max(0, atoi(optarg)); break;
+            case 't': durmaAyar.hedef_skor = atof(optarg); break;
+            case 'Z': durmaAyar.sure_sn = atof(optarg); break;
+            case 'V': durmaAyar.max_degerlendirme = strtoull(optarg, nullptr, 10); break;
+            case 'D': durmaAyar.min_cesitlilik = atof(optarg); break;
+            case 'd': sonTarihMs = atof(optarg); break;
+            case 'u':
+                if (!strcmp(optarg, "none")) kumeAyar.yontem = KUME_YOK;
+                else if (!strcmp(optarg, "grid")) kumeAyar.yontem = KUME_IZGARA;
+                else if (!strcmp(optarg, "kmeans")) kumeAyar.yontem = KUME_KMEANS;
+                else { fprintf(stderr, "Bilinmeyen kumeleme: %s\n", optarg); exit(1); }
+                break;
+            case 'r': kumeAyar.cozunurluk = atof(optarg); break;
+            case 'o': kumeAyar.hata_siniri = atof(optarg); break;
+            case 'q': kumeAyar.k = max(1, atoi(optarg)); break;
+            case 'x': kumeAyar.kesin_son = true; break;
+            case 'j': degerlendirmeThread = max(1, atoi(optarg)); break;
+            case 'w': isciSayisi = max(1, atoi(optarg)); break;
+            case 'a': isciSabitle = true; break;
+            case 'v':
+                if (!logSeviyesiniCoz(optarg, logAyar.seviye)) {
+                    fprintf(stderr, "Bilinmeyen gunluk seviyesi: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'f': logAyar.dosya = optarg; break;
+            case 'F':
+                if (!strcmp(optarg, "json")) logAyar.ikili = false;
+                else if (!strcmp(optarg, "bin")) logAyar.ikili = true;
+                else { fprintf(stderr, "Bilinmeyen gunluk bicimi: %s\n", optarg); exit(1); }
+                break;
+            case 'I':
+                if (!WIFI_IZLEME) fprintf(stderr, "Uyari: izleme derlenmedi (WIFI_IZLEME=0), --trace yok sayildi\n");
+                else izDosyasi = optarg;
+                break;
+            case 'H': perfAktif = true; break;
+            case 'G': panelAktif = true; break;
+            case 'Q': haritaAyar.dosya = optarg; break;
+            case 'i': simAyar.sure = atof(optarg); break;
+            case 'z': topluAyar.manifest = optarg; break;
+            case SEC_TOPLU_BELLEK: topluAyar.bellek_bayt = (size_t)max(1L, atol(optarg)) << 20; break;
+            case SEC_SICAK_BASLANGIC: sicakAyar.kaynak = optarg; break;
+            case SEC_ANLIK_KAYIT: sicakAyar.kayit = optarg; break;
+            case 'y': simAyar.tekrar = max(1, atoi(optarg)); break;
+            case 'U':
+                if (sscanf(optarg, "%dx%d", &haritaAyar.genislik, &haritaAyar.yukseklik) != 2 ||
+                    !haritaBoyutuGecerli(haritaAyar.genislik, haritaAyar.yukseklik)) {
+                    fprintf(stderr, "Gecersiz harita boyutu: %s (ornek 1024x768; kenar <= 4096, en fazla 4M piksel)\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'Y':
+                if (!haritaKipiniCoz(optarg, haritaAyar.kip)) {
+                    fprintf(stderr, "Gecersiz harita kipi: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'J': benchDosyasi = optarg; break;
+            case 'O': logAyar.max_bayt = (size_t)(max(0.001, atof(optarg)) * (1 << 20)); break;
+            case 'P':
+                if (!asamalariCoz(optarg, asamalar)) {
+                    fprintf(stderr, "Gecersiz asama tanimi: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'K':
+                if (!kanalCozucuModunuCoz(optarg, kanalCozucuModu)) {
+                    fprintf(stderr, "Bilinmeyen kanal cozucu modu: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'M':
+                if (!strcmp(optarg, "ga")) calismaModu = MOD_GA;
+                else if (!strcmp(optarg, "nsga2")) calismaModu = MOD_NSGA2;
+                else { fprintf(stderr, "Bilinmeyen mod: %s\n", optarg); exit(1); }
+                break;
+            case 'h': kullanimYazdir(argv[0]); exit(0);
+            default:  kullanimYazdir(argv[0]); exit(1);
         }
     }
-    cv::imwrite("kullanici_haritasi.png", img);  // İzin hatası riski
-#else
-    cout << "[OPENCV KAPALI] Kullanici haritasi olusturulamadi.\n";
-#endif
+    rastgeleBaslat(tohum);
+    printf("Tohum: %llu\n", (unsigned long long)tohum);
 }
 
 // ------------------------------------------------------
@@ -339,25 +5048,22 @@ void gorselOlustur(const vector<AP>& ekip) {
 // ------------------------------------------------------
 
 int main(int argc, char* argv[]) {
-    srand(time(0));
+    argumanlariIsle(argc, argv);
 
-    // Command injection zafiyeti
-    char komut[256];
-    snprintf(komut, sizeof(komut), "echo %s >> log.txt", configDosya.c_str());
-    system(komut);
+    logBaslat();
+    logYaz(LOG_BILGI, "Konfig dosyasi: %s", configDosya.c_str());
+    if (!izDosyasi.empty()) izlemeBaslat();
+    perfBaslat();
 
     // Kullanıcıları konfig dosyasından oku
     konfigDosyasiniOku(configDosya.c_str());
 
     // Rastgele kullanıcı ekle (eğer config boşsa)
-    if (kullanicilar.empty()) {
-        for (int i = 0; i < 5; i++) {
-            AP k; k.x = randint(0, 100); k.y = randint(0, 100);
-            k.kanal = randint(1, 14); k.talep = rand01(gen) * 5;
-            snprintf(k.label, sizeof(k.label), "K%d", i);
-            kullanicilar.push_back(k);
-        }
-    }
+    if (kullanicilar.empty()) rastgeleKullanicilarEkle();
+
+    // Uygunluğun iterasyon yapacağı (gerekirse kümelenmiş) kullanıcı kümesi
+    kullaniciKumesiniHazirla();
+    zamanlayiciyiBaslat();
 
     // Veritabanını aç
     veritabaniAc("wifi_ap.db");
@@ -368,54 +5074,66 @@ int main(int argc, char* argv[]) {
 
     // Genetik Algoritma: Popülasyon oluştur ve çalıştır
     AP_SAYISI = 5;
-    vector<vector<AP>> populasyon;
-    for (int i = 0; i < AP_SAYISI; i++) populasyon.push_back(rastgele_birey());
-
-    for (int epoch = 0; epoch < 100; epoch++) {
-        vector<pair<double, vector<AP>>> skorlu;
-        for (auto& birey : populasyon) {
-            skorlu.push_back({uygunluk(const_cast<vector<AP>&>(birey)), birey});
-        }
-        sort(skorlu.begin(), skorlu.end(), [](auto& a, auto& b) { return a.first > b.first; });
-        if (skorlu[0].first > en_iyi_skor) {
-            en_iyi_skor = skorlu[0].first;
-            en_iyi_birey = skorlu[0].second;
-        }
-        vector<vector<AP>> yeniPop;
-        for (int i = 0; i < 2; i++) yeniPop.push_back(skorlu[i].second);
-        while ((int)yeniPop.size() < AP_SAYISI) {
-            int a = randint(0,2), b = randint(0,2);
-            auto cocuk = crossover(yeniPop[a], yeniPop[b]);
-            cocuk = mutasyon(cocuk);
-            yeniPop.push_back(cocuk);
-        }
-        populasyon = yeniPop;
-    }
-
-    // Sonuçları kaydet
-    kaydetOptimalYerlesim(en_iyi_birey);
-    veritabaniyeYaz(en_iyi_birey);
-
-    // Thread zafiyetleri: eş zamanlı log yazma ve race
-    pthread_t t1, t2;
-    pthread_create(&t1, nullptr, fitnessThread, nullptr);
-    pthread_create(&t2, nullptr, raceConditionThread, nullptr);
+    if (AP_MIN <= 0) AP_MIN = min(AP_SAYISI, AP_MAX > 0 ? AP_MAX : AP_SAYISI);
+    if (AP_MAX <= 0) AP_MAX = max(AP_SAYISI, AP_MIN);
+    if (AP_MAX < AP_MIN) AP_MAX = AP_MIN;
+    if (POP_BOYUTU <= 0) POP_BOYUTU = AP_SAYISI;
+
+    // Toplu mod: senaryolar sırayla, sunucu ve panel olmadan
+    if (!topluAyar.manifest.empty()) {
+        int kod = topluCalistir();
+        zamanlayici.durdur();
+        veritabaniKapat();
+        logDurdur();
+        return kod;
+    }
+    sicakTohumlariHazirla(nullptr);
+    if (panelAktif) panelAktif = panelBaslat();
+    bool paretoYaz = optimizasyonuYurut();
+    if (!benchDosyasi.empty() && !benchJsonYaz(benchDosyasi)) {
+        fprintf(stderr, "Benchmark dosyasi yazilamadi: %s\n", benchDosyasi.c_str());
+    }
+    optimizasyonBitti = true;
+
+    // Sonuçları kaydet: kalıcılık işleri zamanlayıcıdan geçer. Bağlantı
+    // paylaşıldığından SQLite yazımları tek görevde sıralıdır.
+    GorevGrubu kalicilik;
+    zamanlayici.gonder(kalicilik, [] { kaydetOptimalYerlesim(en_iyi_birey); });
+    zamanlayici.gonder(kalicilik, [paretoYaz] {
+        if (paretoYaz) veritabaninaParetoYaz(paretoKumesi);
+        veritabaniyeYaz(en_iyi_birey);
+    });
+    if (!sicakAyar.kayit.empty()) {
+        zamanlayici.gonder(kalicilik, [] {
+            if (!anlikGoruntuYaz(sicakAyar.kayit.c_str(), en_iyi_birey, en_iyi_skor))
+                logYaz(LOG_UYARI, "Anlik goruntu yazilamadi: %s", sicakAyar.kayit.c_str());
+        });
+    }
+    zamanlayici.bekle(kalicilik);
+    if (!izDosyasi.empty() && !izlemeyiDosyayaYaz(izDosyasi)) {
+        fprintf(stderr, "Izleme dosyasi yazilamadi: %s\n", izDosyasi.c_str());
+    }
+
+    // Thread zafiyeti: eş zamanlı log yazma ve race (havuz görevi olarak)
+    GorevGrubu arkaPlan;
+    zamanlayici.gonder(arkaPlan, [] { raceConditionThread(nullptr); });
     sleep(5);
     dur = true;
-    pthread_join(t1, nullptr);
-    pthread_join(t2, nullptr);
+    arkaPlan.iptalEt();
+    zamanlayici.bekle(arkaPlan);
 
-    // REST sunucusu
-    baslatRESTServer();
+    // Canlı panel kullanıcı çıkana kadar açık kalır
+    if (panelAktif) panelBitir();
 
-    // Terminal menüsü
-    terminalMenu();
+    gorselOlustur(en_iyi_birey);
 
-    // Görsel oluştur
-    gorselOlustur(kullanicilar);
+    // REST sunucusu
+    baslatRESTServer();
 
     // Veritabanını kapat
+    zamanlayici.durdur();
     veritabaniKapat();
+    logDurdur();
 
     cout << "\nFinal skor: " << en_iyi_skor << endl;
     return 0;